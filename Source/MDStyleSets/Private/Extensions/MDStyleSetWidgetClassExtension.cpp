@@ -0,0 +1,151 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Extensions/MDStyleSetWidgetClassExtension.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Engine/GameInstance.h"
+#include "Subsystems/MDStyleSetThemeSubsystem.h"
+
+void UMDStyleSetWidgetClassExtension::Initialize(UUserWidget* UserWidget)
+{
+	Super::Initialize(UserWidget);
+
+	if (IsValid(UserWidget) && !Bindings.IsEmpty())
+	{
+		if (BoundProperties.Num() != Bindings.Num())
+		{
+			BuildBoundProperties(UserWidget);
+		}
+
+		// Widgets stay registered for their whole lifetime, so theme changes also reach widgets that are destructed and constructed again (e.g. pooled list entries)
+		if (UMDStyleSetThemeSubsystem* ThemeSubsystem = UGameInstance::GetSubsystem<UMDStyleSetThemeSubsystem>(UserWidget->GetGameInstance()))
+		{
+			ThemeSubsystem->RegisterWidget(UserWidget, this);
+		}
+	}
+}
+
+FMDStyleSetBindingTarget UMDStyleSetWidgetClassExtension::ResolveBindingTarget(UUserWidget* UserWidget, int32 BindingIndex, UWidget*& OutWidget) const
+{
+	OutWidget = nullptr;
+	if (!IsValid(UserWidget) || !Bindings.IsValidIndex(BindingIndex))
+	{
+		return {};
+	}
+
+	if (BoundProperties.IsValidIndex(BindingIndex) && BoundProperties[BindingIndex].Offset != INDEX_NONE)
+	{
+		const FBoundProperty& BoundProperty = BoundProperties[BindingIndex];
+		UWidget* Widget = UserWidget;
+		if (!BoundProperty.WidgetName.IsNone())
+		{
+			Widget = (UserWidget->WidgetTree != nullptr) ? UserWidget->WidgetTree->FindWidget(BoundProperty.WidgetName) : nullptr;
+		}
+
+		if (Widget != nullptr && Widget->IsA(BoundProperty.OwnerClass))
+		{
+			OutWidget = Widget;
+			return { BoundProperty.Property, reinterpret_cast<uint8*>(Widget) + BoundProperty.Offset };
+		}
+	}
+
+	return ResolveBindingPath(UserWidget, Bindings[BindingIndex], OutWidget);
+}
+
+void UMDStyleSetWidgetClassExtension::BuildBoundProperties(UUserWidget* UserWidget)
+{
+	BoundProperties.Reset(Bindings.Num());
+
+	for (const FMDStyleSetPropertyBinding& Binding : Bindings)
+	{
+		FBoundProperty& BoundProperty = BoundProperties.AddDefaulted_GetRef();
+
+		const FPropertyBindingPath& Path = Binding.TargetProperty;
+		int32 FirstSegment = 0;
+		const UStruct* Struct = UserWidget->GetClass();
+		if (Path.NumSegments() > 1 && UserWidget->WidgetTree != nullptr)
+		{
+			if (const UWidget* Widget = UserWidget->WidgetTree->FindWidget(Path.GetSegment(0).GetName()))
+			{
+				BoundProperty.WidgetName = Widget->GetFName();
+				Struct = Widget->GetClass();
+				FirstSegment = 1;
+			}
+		}
+
+		// Only native properties nested in structs have a fixed offset, blueprint classes and structs can be recompiled with a different layout
+		int32 Offset = 0;
+		for (int32 i = FirstSegment; i < Path.NumSegments() && Struct != nullptr; ++i)
+		{
+			const FPropertyBindingPathSegment& Segment = Path.GetSegment(i);
+			const FProperty* Property = Struct->FindPropertyByName(Segment.GetName());
+			if (Property == nullptr || !Property->IsNative() || Property->ArrayDim != 1 || Segment.GetArrayIndex() != INDEX_NONE || Segment.GetInstanceStruct() != nullptr)
+			{
+				break;
+			}
+
+			if (i == FirstSegment)
+			{
+				BoundProperty.OwnerClass = Property->GetOwnerClass();
+			}
+
+			Offset += Property->GetOffset_ForInternal();
+			if (i == Path.NumSegments() - 1 && BoundProperty.OwnerClass != nullptr)
+			{
+				BoundProperty.Property = Property;
+				BoundProperty.Offset = Offset;
+			}
+			else
+			{
+				const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+				Struct = (StructProperty != nullptr) ? StructProperty->Struct : nullptr;
+			}
+		}
+	}
+}
+
+FMDStyleSetBindingTarget UMDStyleSetWidgetClassExtension::ResolveBindingPath(UUserWidget* UserWidget, const FMDStyleSetPropertyBinding& Binding, UWidget*& OutWidget)
+{
+	OutWidget = nullptr;
+
+	FMDStyleSetBindingTarget Target;
+	if (!IsValid(UserWidget) || Binding.TargetProperty.NumSegments() == 0)
+	{
+		return Target;
+	}
+
+	TArray<FPropertyBindingPathIndirection> Indirections;
+
+	// Bindings to a widget in the tree start with the widget's name, which isn't necessarily a property of the user widget
+	UWidget* FirstWidget = (UserWidget->WidgetTree != nullptr) ? UserWidget->WidgetTree->FindWidget(Binding.TargetProperty.GetSegment(0).GetName()) : nullptr;
+	if (FirstWidget != nullptr)
+	{
+		FPropertyBindingPath TrimmedPath;
+		for (int32 i = 1; i < Binding.TargetProperty.NumSegments(); ++i)
+		{
+			TrimmedPath.AddPathSegment(Binding.TargetProperty.GetSegment(i));
+		}
+
+		TrimmedPath.ResolveIndirectionsWithValue(FirstWidget, Indirections, nullptr, true);
+		OutWidget = FirstWidget;
+	}
+	else
+	{
+		Binding.TargetProperty.ResolveIndirectionsWithValue(UserWidget, Indirections, nullptr, true);
+		OutWidget = UserWidget;
+	}
+
+	if (!Indirections.IsEmpty() && Indirections.Last().GetContainerAddress() != nullptr)
+	{
+		Target.Property = Indirections.Last().GetProperty();
+		Target.Address = Indirections.Last().GetMutablePropertyAddress();
+	}
+	else
+	{
+		OutWidget = nullptr;
+	}
+
+	return Target;
+}
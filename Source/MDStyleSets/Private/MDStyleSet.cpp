@@ -3,33 +3,85 @@
 #include "MDStyleSet.h"
 
 #include "AssetRegistry/AssetData.h"
+#include "Engine/ResourceSize.h"
+#include "MDStyleSets.h"
+#include "Misc/DataValidation.h"
+#include "Serialization/ArchiveCountMem.h"
 #include "TypeHandlers/MDStyleSetTypeHandlerBase.h"
 #include "UObject/AssetRegistryTagsContext.h"
+#include "Util/MDStyleSetBindingPathResolver.h"
+#include "Util/MDStyleSetConvertibleType.h"
 
-const FName FMDStyleValue::ValuePropertyName = TEXT("Value");
+#include <atomic>
 
-TTuple<FPropertyBagPropertyDesc, const uint8*> FMDStyleValue::GetValue() const
+namespace MDSS
 {
-	if (const FPropertyBagPropertyDesc* Desc = Value.FindPropertyDescByName(ValuePropertyName))
+	// Memory of the bag's value and of everything it allocates, e.g. strings, containers and nested arrays of struct values.
+	// The heap memory is counted by serializing the value with a memory counting archive, so it's the memory the values report with CountBytes.
+	// The bag struct itself is shared by every bag with the same properties and objects referenced by the value aren't included.
+	SIZE_T GetPropertyBagAllocatedSize(const FInstancedPropertyBag& Bag)
 	{
-		struct LazyHack : FInstancedPropertyBag
+		const UPropertyBag* BagStruct = Bag.GetPropertyBagStruct();
+		const uint8* Memory = Bag.GetValue().GetMemory();
+		if (BagStruct == nullptr || Memory == nullptr)
 		{
-			const uint8* GetValueAddressFromDesc(const FPropertyBagPropertyDesc* Desc) const
-			{
-				return static_cast<const uint8*>(GetValueAddress(Desc));
-			}
-		};
+			return 0;
+		}
+
+		FArchiveCountMem CountMem(nullptr);
+		BagStruct->SerializeBin(CountMem, const_cast<uint8*>(Memory));
+
+		return BagStruct->GetStructureSize() + CountMem.GetMax();
+	}
+}
+
+const FName FMDStyleValue::ValuePropertyName = TEXT("Value");
+
+FMDStyleValueView FMDStyleValue::GetValueView() const
+{
+	const FPropertyBagPropertyDesc* Desc = GetValueDesc();
+	return { Desc, GetValuePtr(Desc) };
+}
+
+TTuple<FPropertyBagPropertyDesc, const uint8*> FMDStyleValue::GetValue() const
+{
+	return GetValueView().ToTuple();
+}
+
+const FPropertyBagPropertyDesc* FMDStyleValue::GetValueDesc() const
+{
+	return Value.FindPropertyDescByName(ValuePropertyName);
+}
 
-		const uint8* ValuePtr = static_cast<const LazyHack&>(Value).GetValueAddressFromDesc(Desc);
-		return { *Desc, ValuePtr };
+const uint8* FMDStyleValue::GetValuePtr(const FPropertyBagPropertyDesc* Desc) const
+{
+	if (Desc == nullptr)
+	{
+		return nullptr;
 	}
 
-	return {};
+	struct LazyHack : FInstancedPropertyBag
+	{
+		const uint8* GetValueAddressFromDesc(const FPropertyBagPropertyDesc* Desc) const
+		{
+			return static_cast<const uint8*>(GetValueAddress(Desc));
+		}
+	};
+
+	return static_cast<const LazyHack&>(Value).GetValueAddressFromDesc(Desc);
 }
 
 const FName UMDStyleSet::ConvertibleTypesAssetTagName = TEXT("ConvertibleTypesAssetTag");
+const FName UMDStyleSet::DisplayNameAssetTagName = TEXT("StyleSetDisplayName");
+const FName UMDStyleSet::StyleTypeAssetTagName = TEXT("StyleSetStyleType");
+const FName UMDStyleSet::StyleSetTagAssetTagName = TEXT("StyleSetTag");
+const FName UMDStyleSet::EntryCountAssetTagName = TEXT("StyleSetEntryCount");
+const FName UMDStyleSet::PackedValuesPropertyName = TEXT("Values");
 
 #if WITH_EDITOR
+UMDStyleSet::FOnStyleSetEdited UMDStyleSet::OnStyleSetEdited;
+UMDStyleSet::FGatherReferencedTags UMDStyleSet::GatherReferencedTagsForCook;
+
 EPropertyBagPropertyType UMDStyleSet::GetValueTypeFromPinType(const FEdGraphPinType& PinType)
 {
 	if (PinType.PinCategory == TEXT("bool"))
@@ -104,6 +156,22 @@ EPropertyBagPropertyType UMDStyleSet::GetValueTypeFromPinType(const FEdGraphPinT
 	return EPropertyBagPropertyType::None;
 }
 
+void UMDStyleSet::PreEditChange(FProperty* PropertyAboutToChange)
+{
+	Super::PreEditChange(PropertyAboutToChange);
+
+	if (!SavedValueHashes.IsSet())
+	{
+		SavedValueHashes = CalculateValueHashes();
+	}
+
+	PreEditEntryTags.Reset();
+	StyleEntries.GetKeys(PreEditEntryTags);
+
+	// The entries may be reallocated while editing, lookups will use the entry map until the table is rebuilt
+	ResetLookupTable();
+}
+
 void UMDStyleSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
@@ -125,125 +193,1089 @@ void UMDStyleSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedE
 			}
 		}
 	}
+
+	if (BaseStyleSet == this)
+	{
+		BaseStyleSet = nullptr;
+	}
+
+	UpdateVersions(PropertyChangedEvent);
+	RebuildLookupTable();
+
+	OnStyleSetEdited.Broadcast(this);
 }
 
-EDataValidationResult UMDStyleSet::IsDataValid(FDataValidationContext& Context) const
+void UMDStyleSet::PostEditUndo()
 {
-	EDataValidationResult Result = EDataValidationResult::Valid;
+	Super::PostEditUndo();
 
-	return CombineDataValidationResults(Result, Super::IsDataValid(Context));
+	BumpSetVersion();
+	RebuildLookupTable();
+
+	OnStyleSetEdited.Broadcast(this);
 }
-#endif
 
-void UMDStyleSet::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+TArray<FGameplayTag> UMDStyleSet::ConsumeChangedTags()
 {
-	Super::GetAssetRegistryTags(Context);
+	TArray<FGameplayTag> ChangedTags;
+	if (!SavedValueHashes.IsSet())
+	{
+		return ChangedTags;
+	}
 
-	static const FPropertyBagPropertyDesc DefaultDesc;
+	TMap<FGameplayTag, uint32> PreviousHashes = MoveTemp(SavedValueHashes.GetValue());
+	SavedValueHashes.Reset();
 
-	TArray<FPropertyBagPropertyDesc> ConvertibleTypes;
-	if (IsValid(TypeHandler))
+	for (const TPair<FGameplayTag, uint32>& Pair : CalculateValueHashes())
 	{
-		TypeHandler->GetConvertibleTypes(ConvertibleTypes);
+		const uint32* PreviousHash = PreviousHashes.Find(Pair.Key);
+		if (PreviousHash == nullptr || *PreviousHash != Pair.Value)
+		{
+			ChangedTags.Add(Pair.Key);
+		}
+
+		PreviousHashes.Remove(Pair.Key);
 	}
 
-	if (const FPropertyBagPropertyDesc* Desc = FallbackValue.Value.FindPropertyDescByName(FMDStyleValue::ValuePropertyName))
+	// Removed entries now resolve to the fallback value
+	for (const TPair<FGameplayTag, uint32>& Pair : PreviousHashes)
 	{
-		ConvertibleTypes.Add(*Desc);
+		ChangedTags.Add(Pair.Key);
 	}
 
-	FStringBuilderBase ConvertibleTypesStringBuilder;
+	return ChangedTags;
+}
 
-	for (const FPropertyBagPropertyDesc& Type : ConvertibleTypes)
+TMap<FGameplayTag, FMDStyleValue> UMDStyleSet::GetCookedEntries() const
+{
+	TSet<FGameplayTag> ReferencedTags;
+	if (!bStripUnreferencedEntries || !GatherReferencedTagsForCook.IsBound() || !GatherReferencedTagsForCook.Execute(this, ReferencedTags))
 	{
-		FString DescString;
-		FPropertyBagPropertyDesc::StaticStruct()->ExportText(DescString, &Type, &DefaultDesc, nullptr, PPF_None, nullptr);
+		return StyleEntries;
+	}
 
-		if (ConvertibleTypesStringBuilder.Len() == 0)
+	// Tags can fall back to the entry of a parent tag, so keep the parents of every referenced tag
+	TSet<FGameplayTag> KeptTags;
+	for (const FGameplayTag& Tag : ReferencedTags)
+	{
+		for (FGameplayTag ParentTag = Tag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
 		{
-			ConvertibleTypesStringBuilder = DescString;
+			bool bIsAlreadyKept = false;
+			KeptTags.Add(ParentTag, &bIsAlreadyKept);
+			if (bIsAlreadyKept)
+			{
+				break;
+			}
 		}
-		else
+	}
+
+	TMap<FGameplayTag, FMDStyleValue> CookedEntries;
+	for (const TPair<FGameplayTag, FMDStyleValue>& Pair : StyleEntries)
+	{
+		if (KeptTags.Contains(Pair.Key) || Pair.Key.MatchesAny(CookKeepTags))
 		{
-			ConvertibleTypesStringBuilder.Appendf(TEXT("\n%s"), *DescString);
+			CookedEntries.Add(Pair.Key, Pair.Value);
 		}
 	}
 
-	FAssetRegistryTag StyleTypeTag = {
-		ConvertibleTypesAssetTagName,
-		ConvertibleTypesStringBuilder.ToString(),
-		FAssetRegistryTag::TT_Hidden
-	};
-	Context.AddTag(MoveTemp(StyleTypeTag));
+	return CookedEntries;
 }
 
-TTuple<FPropertyBagPropertyDesc, const uint8*> UMDStyleSet::GetStyleValue(const FGameplayTag& ValueTag) const
+TMap<FGameplayTag, uint32> UMDStyleSet::CalculateValueHashes() const
 {
-	if (const FMDStyleValue* ValuePtr = StyleEntries.Find(ValueTag))
+	TMap<FGameplayTag, uint32> Hashes;
+
+	FString ValueString;
+	for (const FGameplayTag& Tag : GetStyleTags())
 	{
-		return ValuePtr->GetValue();
+		const FMDStyleValueView Value = GetStyleValueView(Tag);
+		if (Value.IsValid())
+		{
+			ValueString.Reset();
+			Value.GetProperty()->ExportTextItem_Direct(ValueString, Value.GetMemory(), nullptr, nullptr, PPF_None);
+			Hashes.Add(Tag, FCrc::StrCrc32(*ValueString));
+		}
 	}
 
-	return FallbackValue.GetValue();
+	return Hashes;
 }
 
-bool UMDStyleSet::TrySetPropertyValue(const FGameplayTag& ValueTag, const FProperty* DestProp, void* DestPtr) const
+uint32 UMDStyleSet::GetEntryVersion(const FGameplayTag& ValueTag) const
 {
-	if (DestProp != nullptr && DestPtr != nullptr)
+	uint32 Version = 0;
+
+	TArray<const UMDStyleSet*, TInlineAllocator<4>> VisitedStyleSets;
+	for (const UMDStyleSet* StyleSet = this; IsValid(StyleSet) && !VisitedStyleSets.Contains(StyleSet); StyleSet = StyleSet->BaseStyleSet)
 	{
-		TTuple<FPropertyBagPropertyDesc, const uint8*> Value = GetStyleValue(ValueTag);
-		if (Value.Value != nullptr)
+		VisitedStyleSets.Add(StyleSet);
+		Version = HashCombineFast(Version, GetTypeHash(StyleSet->SetVersion));
+
+		// Missing tags can resolve to the entry of a parent tag
+		for (FGameplayTag Tag = ValueTag; Tag.IsValid(); Tag = bFallbackToParentTags ? Tag.RequestDirectParent() : FGameplayTag())
 		{
-			const FPropertyBagPropertyDesc DestDesc = { FMDStyleValue::ValuePropertyName, DestProp };
-			if (DestDesc.CompatibleType(Value.Key))
+			if (const int64* EntryVersion = StyleSet->EntryVersions.Find(Tag))
 			{
-				DestProp->CopyCompleteValue(DestPtr, Value.Value);
-				return true;
+				Version = HashCombineFast(Version, GetTypeHash(*EntryVersion));
 			}
+		}
+	}
+
+	return Version != 0 ? Version : 1;
+}
 
-			if (IsValid(TypeHandler))
+void UMDStyleSet::UpdateVersions(const FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Changing an entry's key is also a ValueSet edit, but bindings to the previous tag need to be applied again to find it's gone
+	TArray<FGameplayTag> EntryTags;
+	StyleEntries.GetKeys(EntryTags);
+	const bool bHaveKeysChanged = EntryTags != PreEditEntryTags;
+	PreEditEntryTags.Reset();
+
+	constexpr uint32 EntryValueChangeTypes = EPropertyChangeType::ValueSet | EPropertyChangeType::Interactive;
+	if (!bHaveKeysChanged
+		&& PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UMDStyleSet, StyleEntries)
+		&& (PropertyChangedEvent.ChangeType & EntryValueChangeTypes) != 0)
+	{
+		const int32 EntryIndex = PropertyChangedEvent.GetArrayIndex(GET_MEMBER_NAME_STRING_CHECKED(UMDStyleSet, StyleEntries));
+		int32 Index = 0;
+		for (const TPair<FGameplayTag, FMDStyleValue>& Pair : StyleEntries)
+		{
+			if (Index++ == EntryIndex)
 			{
-				return TypeHandler->TrySetValue(Value, DestDesc, DestPtr);
+				EntryVersions.Add(Pair.Key, MakeVersion());
+				return;
 			}
 		}
 	}
 
-	return false;
+	BumpSetVersion();
 }
 
-FText UMDStyleSet::GetValueDisplayName(const FGameplayTag& ValueTag) const
+void UMDStyleSet::BumpSetVersion()
+{
+	SetVersion = MakeVersion();
+}
+
+int64 UMDStyleSet::MakeVersion()
+{
+	LastVersion = FMath::Max(FDateTime::UtcNow().GetTicks(), LastVersion + 1);
+	return LastVersion;
+}
+
+FBlake3Hash UMDStyleSet::GetContentHash() const
 {
+	// The version changes whenever the entries, fallback or base Style Set are edited
+	if (CachedContentHashVersion != 0 && CachedContentHashVersion == LookupTableVersion)
+	{
+		return CachedContentHash;
+	}
+
+	FBlake3 Hasher;
+	auto UpdateString = [&Hasher](const FString& String)
+	{
+		// Hash UTF-8 so the result doesn't depend on the platform's TCHAR size
+		const FTCHARToUTF8 Utf8String(*String);
+		Hasher.Update(Utf8String.Get(), Utf8String.Length() + 1);
+	};
+
+	FString ExportString;
+	FEdGraphPinType::StaticStruct()->ExportText(ExportString, &StyleType, nullptr, nullptr, PPF_None, nullptr);
+	UpdateString(ExportString);
+
+	UpdateString(GetPathNameSafe(IsValid(TypeHandler) ? TypeHandler->GetClass() : nullptr));
 	if (IsValid(TypeHandler))
 	{
-		return TypeHandler->GetValueAsText(this, ValueTag);
+		for (TFieldIterator<FProperty> It(TypeHandler->GetClass()); It; ++It)
+		{
+			ExportString.Reset();
+			It->ExportText_InContainer(0, ExportString, TypeHandler, nullptr, nullptr, PPF_None);
+			UpdateString(ExportString);
+		}
 	}
 
-	TTuple<FPropertyBagPropertyDesc, const uint8*> Value = GetStyleValue(ValueTag);
-	if (Value.Key.CachedProperty != nullptr && Value.Value != nullptr)
+	const uint8 bFallbackToParentTagsByte = bFallbackToParentTags ? 1 : 0;
+	Hasher.Update(&bFallbackToParentTagsByte, sizeof(bFallbackToParentTagsByte));
+
+	auto UpdateValue = [&UpdateString, &ExportString](const FMDStyleValueView& Value)
 	{
-		FString ValueString;
-		if (Value.Key.CachedProperty->ExportText_Direct(ValueString, Value.Value, Value.Value, nullptr, PPF_None))
+		ExportString.Reset();
+		if (Value.IsValid())
 		{
-			return FText::FromString(ValueString);
+			Value.GetProperty()->ExportTextItem_Direct(ExportString, Value.GetMemory(), nullptr, nullptr, PPF_None);
 		}
+
+		UpdateString(ExportString);
+	};
+
+	UpdateValue(FallbackValue.GetValueView());
+
+	// Inherited entries are included through their resolved values, in a stable order
+	TArray<FGameplayTag> Tags = GetStyleTags();
+	Tags.Sort([](const FGameplayTag& A, const FGameplayTag& B)
+	{
+		return A.GetTagName().LexicalLess(B.GetTagName());
+	});
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		UpdateString(Tag.ToString());
+		UpdateValue(GetStyleValueView(Tag));
 	}
 
-	return INVTEXT("Invalid Value");
+	CachedContentHash = Hasher.Finalize();
+	CachedContentHashVersion = LookupTableVersion;
+	return CachedContentHash;
 }
 
-bool UMDStyleSet::DoesHaveValueWithTag(const FGameplayTag& ValueTag) const
+EDataValidationResult UMDStyleSet::IsDataValid(FDataValidationContext& Context) const
 {
-	return StyleEntries.Contains(ValueTag);
+	EDataValidationResult Result = EDataValidationResult::Valid;
+
+	if (IsValid(BaseStyleSet))
+	{
+		TSet<const UMDStyleSet*> VisitedStyleSets = { this };
+		for (const UMDStyleSet* StyleSet = BaseStyleSet; IsValid(StyleSet); StyleSet = StyleSet->BaseStyleSet)
+		{
+			bool bIsAlreadyVisited = false;
+			VisitedStyleSets.Add(StyleSet, &bIsAlreadyVisited);
+			if (bIsAlreadyVisited)
+			{
+				Context.AddError(FText::Format(INVTEXT("Base Style Set [{0}] ends up referencing itself as a base"), BaseStyleSet->GetDisplayName()));
+				Result = EDataValidationResult::Invalid;
+				break;
+			}
+		}
+
+		if (BaseStyleSet->StyleType != StyleType)
+		{
+			Context.AddError(FText::Format(INVTEXT("Base Style Set [{0}] has a different Style Type"), BaseStyleSet->GetDisplayName()));
+			Result = EDataValidationResult::Invalid;
+		}
+	}
+
+	return CombineDataValidationResults(Result, Super::IsDataValid(Context));
 }
+#endif
 
-void UMDStyleSet::SortEntries()
+void UMDStyleSet::Serialize(FArchive& Ar)
 {
+	LLM_SCOPE_BYTAG(MDStyleSets);
+
 #if WITH_EDITOR
-	PreEditChange(GetClass()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(UMDStyleSet, StyleEntries)));
+	if ((bPackEntryStorage || bStripUnreferencedEntries) && Ar.IsSaving() && Ar.IsCooking())
+	{
+		// Swap the entries for their cooked version only while saving so the editor keeps working with all the individual entries
+		TMap<FGameplayTag, FMDStyleValue> CookedEntries = GetCookedEntries();
+		TMap<FGameplayTag, FMDStyleValue> EditorEntries = MoveTemp(StyleEntries);
+		StyleEntries = MoveTemp(CookedEntries);
+		if (bPackEntryStorage)
+		{
+			StyleEntries = PackEntries();
+		}
 
-	StyleEntries.KeySort([](const FGameplayTag& A, const FGameplayTag& B)
+		Super::Serialize(Ar);
+
+		StyleEntries = MoveTemp(EditorEntries);
+		PackedEntryTags.Reset();
+		PackedEntryValues.Reset();
+		return;
+	}
+#endif
+
+	// Loading reallocates the values, e.g. when undoing an edit, the table is rebuilt in PostLoad or PostEditUndo
+	if (Ar.IsLoading())
 	{
-		return !B.IsValid() || (A.IsValid() && A.ToString() < B.ToString());
-	});
+		ResetLookupTable();
+	}
+
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading())
+	{
+		// Lookups before PostLoad search the packed entries directly, which needs the desc of a single packed value
+		UpdatePackedValueDesc();
+	}
+}
+
+void UMDStyleSet::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildLookupTable();
+}
+
+void UMDStyleSet::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+
+	TArray<FPropertyBagPropertyDesc> ConvertibleTypes;
+	if (IsValid(TypeHandler))
+	{
+		TypeHandler->GetConvertibleTypes(ConvertibleTypes);
+	}
+
+	if (const FPropertyBagPropertyDesc* Desc = FallbackValue.Value.FindPropertyDescByName(FMDStyleValue::ValuePropertyName))
+	{
+		ConvertibleTypes.Add(*Desc);
+	}
+
+	FAssetRegistryTag StyleTypeTag = {
+		ConvertibleTypesAssetTagName,
+		FMDStyleSetConvertibleType::EncodeTagValue(ConvertibleTypes),
+		FAssetRegistryTag::TT_Hidden
+	};
+	Context.AddTag(MoveTemp(StyleTypeTag));
+
+	Context.AddTag(FAssetRegistryTag(DisplayNameAssetTagName, GetDisplayName().ToString(), FAssetRegistryTag::TT_Alphabetical));
+	Context.AddTag(FAssetRegistryTag(StyleSetTagAssetTagName, StyleSetTag.ToString(), FAssetRegistryTag::TT_Alphabetical));
+	Context.AddTag(FAssetRegistryTag(EntryCountAssetTagName, LexToString(GetStyleTags().Num()), FAssetRegistryTag::TT_Numerical));
+
+	// Category;SubCategory;SubCategoryObjectPath;ContainerType
+	const FString StyleTypeString = FString::Printf(TEXT("%s;%s;%s;%d"),
+		*StyleType.PinCategory.ToString(),
+		*StyleType.PinSubCategory.ToString(),
+		*FSoftObjectPath(StyleType.PinSubCategoryObject.Get()).ToString(),
+		static_cast<int32>(StyleType.ContainerType));
+	Context.AddTag(FAssetRegistryTag(StyleTypeAssetTagName, StyleTypeString, FAssetRegistryTag::TT_Hidden));
+}
+
+void UMDStyleSet::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	SIZE_T Size = StyleEntries.GetAllocatedSize();
+	for (const TPair<FGameplayTag, FMDStyleValue>& Pair : StyleEntries)
+	{
+		Size += MDSS::GetPropertyBagAllocatedSize(Pair.Value.Value);
+	}
+
+	Size += MDSS::GetPropertyBagAllocatedSize(FallbackValue.Value);
+	Size += PackedEntryTags.GetAllocatedSize();
+	Size += MDSS::GetPropertyBagAllocatedSize(PackedEntryValues);
+	Size += LookupTable.GetAllocatedSize();
+	Size += OwnLookupTable.GetAllocatedSize();
+	Size += ConversionTable.GetAllocatedSize();
+	{
+		FReadScopeLock ReadLock(ParentTagEntryIndicesLock);
+		Size += ParentTagEntryIndices.GetAllocatedSize();
+	}
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Size);
+
+	// The type handler is its own object, it's only included when estimating the total so it isn't counted twice when listing objects
+	if (IsValid(TypeHandler) && CumulativeResourceSize.GetResourceSizeMode() == EResourceSizeMode::EstimatedTotal)
+	{
+		TypeHandler->GetResourceSizeEx(CumulativeResourceSize);
+	}
+}
+
+FText UMDStyleSet::GetDisplayNameFromAssetData(const FAssetData& Asset)
+{
+	FString DisplayNameString;
+	if (Asset.GetTagValue(DisplayNameAssetTagName, DisplayNameString) && !DisplayNameString.IsEmpty())
+	{
+		return FText::FromString(DisplayNameString);
+	}
+
+	return FText::FromName(Asset.AssetName);
+}
+
+FGameplayTag UMDStyleSet::GetStyleSetTagFromAssetData(const FAssetData& Asset)
+{
+	FString TagString;
+	if (Asset.GetTagValue(StyleSetTagAssetTagName, TagString) && !TagString.IsEmpty())
+	{
+		return FGameplayTag::RequestGameplayTag(FName(TagString), false);
+	}
+
+	return FGameplayTag::EmptyTag;
+}
+
+int32 UMDStyleSet::GetEntryCountFromAssetData(const FAssetData& Asset)
+{
+	int32 EntryCount = 0;
+	Asset.GetTagValue(EntryCountAssetTagName, EntryCount);
+	return EntryCount;
+}
+
+bool UMDStyleSet::GetStyleTypeFromAssetData(const FAssetData& Asset, FEdGraphPinType& OutStyleType)
+{
+	FString StyleTypeString;
+	if (!Asset.GetTagValue(StyleTypeAssetTagName, StyleTypeString))
+	{
+		return false;
+	}
+
+	TArray<FString> Fields;
+	StyleTypeString.ParseIntoArray(Fields, TEXT(";"), false);
+	if (Fields.Num() != 4)
+	{
+		return false;
+	}
+
+	OutStyleType = FEdGraphPinType();
+	OutStyleType.PinCategory = FName(Fields[0]);
+	OutStyleType.PinSubCategory = Fields[1].IsEmpty() ? NAME_None : FName(Fields[1]);
+	OutStyleType.PinSubCategoryObject = FSoftObjectPath(Fields[2]).ResolveObject();
+	OutStyleType.ContainerType = static_cast<EPinContainerType>(FCString::Atoi(*Fields[3]));
+	return true;
+}
+
+void UMDStyleSet::BumpLookupTableVersion()
+{
+	// Shared by all Style Sets so a Style Set allocated where a destroyed one was never matches its version
+	static std::atomic<uint32> NextLookupTableVersion = 1;
+	LookupTableVersion = NextLookupTableVersion++;
+}
+
+void UMDStyleSet::RebuildLookupTable()
+{
+	LLM_SCOPE_BYTAG(MDStyleSets);
+
+	// Guards against cycles of base Style Sets
+	if (bIsRebuildingLookupTable)
+	{
+		return;
+	}
+
+	TGuardValue<bool> RebuildGuard(bIsRebuildingLookupTable, true);
+
+	UMDStyleSet* Base = GetValidBaseStyleSet();
+	if (Base != nullptr && Base->HasAnyFlags(RF_NeedPostLoad))
+	{
+		Base->ConditionalPostLoad();
+	}
+
+	// With a base Style Set, our own entries are kept in their own table so changes to the base only need to merge it again
+	FMDStyleSetLookupTable& EntriesTable = (Base != nullptr) ? OwnLookupTable : LookupTable;
+	OwnLookupTable.Reset();
+	LookupTable.Reset();
+
+	const FPropertyBagPropertyDesc* FallbackDesc = FallbackValue.GetValueDesc();
+	EntriesTable.SetFallback(FallbackDesc, FallbackValue.GetValuePtr(FallbackDesc));
+
+	UpdatePackedValueDesc();
+	if (const FPropertyBagPropertyDesc* PackedDesc = PackedEntryValues.FindPropertyDescByName(PackedValuesPropertyName))
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(PackedDesc->CachedProperty))
+		{
+			FScriptArrayHelper PackedValues(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(PackedEntryValues.GetValue().GetMemory()));
+			const int32 NumPacked = FMath::Min(PackedValues.Num(), PackedEntryTags.Num());
+			for (int32 i = 0; i < NumPacked; ++i)
+			{
+				EntriesTable.AddEntry(PackedEntryTags[i], &PackedValueDesc, PackedValues.GetRawPtr(i));
+			}
+		}
+	}
+
+	for (const TPair<FGameplayTag, FMDStyleValue>& Pair : StyleEntries)
+	{
+		const FPropertyBagPropertyDesc* Desc = Pair.Value.GetValueDesc();
+		EntriesTable.AddEntry(Pair.Key, Desc, Pair.Value.GetValuePtr(Desc));
+	}
+
+	EntriesTable.Finalize();
+
+	if (Base != nullptr)
+	{
+		Base->DependentStyleSets.AddUnique(this);
+	}
+
+	FinishRebuildingLookupTable(Base);
+}
+
+void UMDStyleSet::RebuildInheritedEntries()
+{
+	const UMDStyleSet* Base = GetValidBaseStyleSet();
+	if (Base == nullptr || !OwnLookupTable.IsBuilt())
+	{
+		RebuildLookupTable();
+		return;
+	}
+
+	if (bIsRebuildingLookupTable)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(MDStyleSets);
+	TGuardValue<bool> RebuildGuard(bIsRebuildingLookupTable, true);
+
+	FinishRebuildingLookupTable(Base);
+}
+
+void UMDStyleSet::FinishRebuildingLookupTable(const UMDStyleSet* Base)
+{
+	// Flatten the base's entries into our table so lookups never walk the chain of base Style Sets
+	if (Base != nullptr)
+	{
+		LookupTable.Merge(OwnLookupTable, Base->LookupTable);
+	}
+
+	BumpLookupTableVersion();
+	ResetParentTagEntryIndices();
+
+	ConversionTable.Reset();
+	RebuildConversionTable();
+
+	RebuildDependentLookupTables();
+}
+
+UMDStyleSet* UMDStyleSet::GetValidBaseStyleSet() const
+{
+	return (IsValid(BaseStyleSet) && BaseStyleSet != this) ? BaseStyleSet.Get() : nullptr;
+}
+
+void UMDStyleSet::ResetLookupTable()
+{
+	OwnLookupTable.Reset();
+	ResetFlattenedLookupTable();
+}
+
+void UMDStyleSet::ResetFlattenedLookupTable()
+{
+	// Also stops at cycles of base Style Sets, since their table was already reset
+	if (!LookupTable.IsBuilt())
+	{
+		return;
+	}
+
+	LookupTable.Reset();
+	ConversionTable.Reset();
+	BumpLookupTableVersion();
+	ResetParentTagEntryIndices();
+
+	// Dependent tables point to our values, which are about to change. Their own entries are unchanged so only their flattened table is reset.
+	for (const TWeakObjectPtr<UMDStyleSet>& DependentStyleSet : DependentStyleSets)
+	{
+		if (DependentStyleSet.IsValid() && DependentStyleSet->BaseStyleSet == this)
+		{
+			DependentStyleSet->ResetFlattenedLookupTable();
+		}
+	}
+}
+
+void UMDStyleSet::RebuildDependentLookupTables()
+{
+	DependentStyleSets.RemoveAllSwap([this](const TWeakObjectPtr<UMDStyleSet>& DependentStyleSet)
+	{
+		return !DependentStyleSet.IsValid() || DependentStyleSet->BaseStyleSet != this;
+	});
+
+	const TArray<TWeakObjectPtr<UMDStyleSet>> StyleSetsToRebuild = DependentStyleSets;
+	for (const TWeakObjectPtr<UMDStyleSet>& DependentStyleSet : StyleSetsToRebuild)
+	{
+		if (UMDStyleSet* StyleSet = DependentStyleSet.Get())
+		{
+			StyleSet->RebuildInheritedEntries();
+		}
+	}
+}
+
+void UMDStyleSet::RebuildConversionTable()
+{
+	const FPropertyBagPropertyDesc* SourceDesc = LookupTable.GetSharedDesc();
+	if (SourceDesc == nullptr)
+	{
+		return;
+	}
+
+	ConversionTable.SetSourceDesc(SourceDesc);
+
+	const FMDStyleSetTypeKey SourceKey = FMDStyleSetTypeKey::FromDesc(*SourceDesc);
+	ConversionTable.AddKernel(SourceKey, &FMDStyleSetConversionTable::CopyValue);
+
+	if (IsValid(TypeHandler))
+	{
+		TArray<FPropertyBagPropertyDesc> ConvertibleTypes;
+		TypeHandler->GetConvertibleTypes(ConvertibleTypes);
+
+		for (const FPropertyBagPropertyDesc& ConvertibleType : ConvertibleTypes)
+		{
+			const FMDStyleSetTypeKey DestKey = FMDStyleSetTypeKey::FromDesc(ConvertibleType);
+			if (DestKey != SourceKey)
+			{
+				ConversionTable.AddKernel(DestKey, TypeHandler->GetConversionKernel(SourceKey, DestKey));
+			}
+		}
+	}
+}
+
+#if WITH_EDITOR
+TMap<FGameplayTag, FMDStyleValue> UMDStyleSet::PackEntries()
+{
+	PackedEntryTags.Reset();
+	PackedEntryValues.Reset();
+
+	TMap<FGameplayTag, FMDStyleValue> UnpackedEntries;
+
+	const FPropertyBagPropertyDesc* StyleDesc = FallbackValue.GetValueDesc();
+	for (auto It = StyleEntries.CreateConstIterator(); StyleDesc == nullptr && It; ++It)
+	{
+		StyleDesc = It->Value.GetValueDesc();
+	}
+
+	// Property bags don't support nested containers so container style types stay unpacked
+	if (StyleDesc == nullptr || StyleDesc->ContainerTypes.Num() > 0)
+	{
+		UnpackedEntries = StyleEntries;
+		return UnpackedEntries;
+	}
+
+	PackedEntryValues.AddContainerProperty(PackedValuesPropertyName, EPropertyBagContainerType::Array, StyleDesc->ValueType, const_cast<UObject*>(StyleDesc->ValueTypeObject.Get()));
+
+	const FPropertyBagPropertyDesc* PackedDesc = PackedEntryValues.FindPropertyDescByName(PackedValuesPropertyName);
+	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(PackedDesc != nullptr ? PackedDesc->CachedProperty : nullptr);
+	if (ArrayProperty == nullptr)
+	{
+		PackedEntryValues.Reset();
+		UnpackedEntries = StyleEntries;
+		return UnpackedEntries;
+	}
+
+	FScriptArrayHelper PackedValues(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(PackedEntryValues.GetMutableValue().GetMemory()));
+	PackedEntryTags.Reserve(StyleEntries.Num());
+
+	for (const TPair<FGameplayTag, FMDStyleValue>& Pair : StyleEntries)
+	{
+		const FPropertyBagPropertyDesc* Desc = Pair.Value.GetValueDesc();
+		const uint8* ValuePtr = Pair.Value.GetValuePtr(Desc);
+		if (Desc != nullptr && ValuePtr != nullptr && FMDStyleSetLookupTable::IsSameValueType(*Desc, *StyleDesc))
+		{
+			const int32 Index = PackedValues.AddValue();
+			ArrayProperty->Inner->CopyCompleteValue(PackedValues.GetRawPtr(Index), ValuePtr);
+			PackedEntryTags.Add(Pair.Key);
+		}
+		else
+		{
+			UnpackedEntries.Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	return UnpackedEntries;
+}
+#endif
+
+bool UMDStyleSet::IsOrInheritsFrom(const UMDStyleSet* StyleSet) const
+{
+	TSet<const UMDStyleSet*> VisitedStyleSets;
+	for (const UMDStyleSet* TestStyleSet = this; IsValid(TestStyleSet) && !VisitedStyleSets.Contains(TestStyleSet); TestStyleSet = TestStyleSet->BaseStyleSet)
+	{
+		VisitedStyleSets.Add(TestStyleSet);
+
+		if (TestStyleSet == StyleSet)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TArray<FGameplayTag> UMDStyleSet::GetStyleTags() const
+{
+	TArray<FGameplayTag> Tags;
+	TSet<FGameplayTag> FoundTags;
+
+	TSet<const UMDStyleSet*> VisitedStyleSets;
+	for (const UMDStyleSet* StyleSet = this; IsValid(StyleSet) && !VisitedStyleSets.Contains(StyleSet); StyleSet = StyleSet->BaseStyleSet)
+	{
+		VisitedStyleSets.Add(StyleSet);
+
+		for (const FGameplayTag& Tag : StyleSet->PackedEntryTags)
+		{
+			if (!FoundTags.Contains(Tag))
+			{
+				FoundTags.Add(Tag);
+				Tags.Add(Tag);
+			}
+		}
+
+		for (const TPair<FGameplayTag, FMDStyleValue>& Pair : StyleSet->StyleEntries)
+		{
+			if (!FoundTags.Contains(Pair.Key))
+			{
+				FoundTags.Add(Pair.Key);
+				Tags.Add(Pair.Key);
+			}
+		}
+	}
+
+	return Tags;
+}
+
+FMDStyleValueView UMDStyleSet::GetStyleValueView(const FGameplayTag& ValueTag) const
+{
+	FMDStyleValueView Value;
+	FindStyleValue(ValueTag, Value);
+	return Value;
+}
+
+bool UMDStyleSet::FindStyleValue(const FGameplayTag& ValueTag, FMDStyleValueView& OutValue) const
+{
+	if (LookupTable.IsBuilt())
+	{
+		int32 EntryIndex = LookupTable.FindEntryIndex(ValueTag);
+		if (EntryIndex == INDEX_NONE && bFallbackToParentTags)
+		{
+			EntryIndex = FindParentTagEntryIndex(ValueTag);
+		}
+
+		if (EntryIndex != INDEX_NONE)
+		{
+			OutValue = { LookupTable.GetDesc(EntryIndex), LookupTable.GetValue(EntryIndex) };
+			return true;
+		}
+
+		OutValue = { LookupTable.GetFallbackDesc(), LookupTable.GetFallbackValue() };
+		return false;
+	}
+
+	if (FindUnindexedEntry(ValueTag, OutValue))
+	{
+		return true;
+	}
+
+	if (bFallbackToParentTags)
+	{
+		for (FGameplayTag ParentTag = ValueTag.RequestDirectParent(); ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+		{
+			if (FindUnindexedEntry(ParentTag, OutValue))
+			{
+				return true;
+			}
+		}
+	}
+
+	// Matches the flattened table, which uses the fallback of the closest Style Set that has one
+	OutValue = {};
+	TArray<const UMDStyleSet*, TInlineAllocator<4>> VisitedStyleSets;
+	for (const UMDStyleSet* StyleSet = this; !OutValue.IsValid() && IsValid(StyleSet) && !VisitedStyleSets.Contains(StyleSet); StyleSet = StyleSet->BaseStyleSet)
+	{
+		VisitedStyleSets.Add(StyleSet);
+		OutValue = StyleSet->FallbackValue.GetValueView();
+	}
+
+	return false;
+}
+
+TTuple<FPropertyBagPropertyDesc, const uint8*> UMDStyleSet::GetStyleValue(const FGameplayTag& ValueTag) const
+{
+	return GetStyleValueView(ValueTag).ToTuple();
+}
+
+bool UMDStyleSet::TrySetPropertyValue(const FGameplayTag& ValueTag, const FProperty* DestProp, void* DestPtr) const
+{
+	if (DestProp != nullptr && DestPtr != nullptr)
+	{
+		const FMDStyleValueView Value = GetStyleValueView(ValueTag);
+
+		// Values of the style type go through the cached kernels, which avoids building a desc for the destination property
+		if (Value.IsValid() && Value.GetPropertyDesc() == ConversionTable.GetSourceDesc())
+		{
+			if (const FMDStyleSetConversionKernel Kernel = FindConversionKernel(DestProp))
+			{
+				return Kernel(DestProp, Value.GetMemory(), DestPtr);
+			}
+		}
+
+		return TrySetPropertyValueFromView(Value, DestProp, DestPtr);
+	}
+
+	return false;
+}
+
+bool UMDStyleSet::TrySetPropertyValue(const FGameplayTag& ValueTag, const FProperty* DestProp, void* DestPtr, FMDStyleSetValueCache& Cache) const
+{
+	if (DestProp == nullptr || DestPtr == nullptr)
+	{
+		return false;
+	}
+
+	// Every rebuild or reset of the lookup table changes its version, so cached values are never read after they may have moved
+	if (Cache.StyleSet != this || Cache.Version != LookupTableVersion || Cache.Tag != ValueTag || Cache.DestProp != DestProp)
+	{
+		Cache.Reset();
+
+		// Values found without the lookup table can move without a new version
+		if (!LookupTable.IsBuilt())
+		{
+			return TrySetPropertyValue(ValueTag, DestProp, DestPtr);
+		}
+
+		Cache.StyleSet = this;
+		Cache.Version = LookupTableVersion;
+		Cache.Tag = ValueTag;
+		Cache.DestProp = DestProp;
+		FindStyleValue(ValueTag, Cache.Value);
+
+		if (Cache.Value.IsValid() && Cache.Value.GetPropertyDesc() == ConversionTable.GetSourceDesc())
+		{
+			Cache.Kernel = FindConversionKernel(DestProp);
+		}
+	}
+
+	checkSlow(GetStyleValueView(ValueTag).GetMemory() == Cache.Value.GetMemory());
+
+	if (Cache.Kernel != nullptr)
+	{
+		return Cache.Kernel(DestProp, Cache.Value.GetMemory(), DestPtr);
+	}
+
+	return TrySetPropertyValueFromView(Cache.Value, DestProp, DestPtr);
+}
+
+int32 UMDStyleSet::ApplyBindings(TConstArrayView<FMDStyleSetPropertyBinding> Bindings, TFunctionRef<FMDStyleSetBindingTarget(int32 BindingIndex)> ResolveTarget, TArrayView<EMDStyleSetBindingExecutionResult> OutResults)
+{
+	check(OutResults.IsEmpty() || OutResults.Num() == Bindings.Num());
+
+	// Values and kernels are cached so bindings sharing a Style Set, tag or property only look them up once, while still writing in binding order so overlapping bindings always apply the same way
+	struct FCachedValue
+	{
+		FMDStyleValueView Value;
+		bool bHasValue = false;
+	};
+
+	TMap<TTuple<const UMDStyleSet*, FGameplayTag>, FCachedValue, TInlineSetAllocator<16>> Values;
+	TMap<TTuple<const UMDStyleSet*, const FProperty*>, FMDStyleSetConversionKernel, TInlineSetAllocator<16>> Kernels;
+
+	int32 NumApplied = 0;
+
+	for (int32 BindingIndex = 0; BindingIndex < Bindings.Num(); ++BindingIndex)
+	{
+		const FMDStyleSetPropertyBinding& Binding = Bindings[BindingIndex];
+		// Resolved right before writing, an earlier binding may have written a container this binding's path goes through
+		const FMDStyleSetBindingTarget Target = ResolveTarget(BindingIndex);
+		const UMDStyleSet* StyleSet = Binding.Value.StyleSet;
+
+		EMDStyleSetBindingExecutionResult Result = EMDStyleSetBindingExecutionResult::CouldNotSetValue;
+		if (!IsValid(StyleSet))
+		{
+			Result = EMDStyleSetBindingExecutionResult::StyleNotFound;
+		}
+		else
+		{
+			const TTuple<const UMDStyleSet*, FGameplayTag> ValueKey(StyleSet, Binding.Value.StyleValueTag);
+			FCachedValue* CachedValue = Values.Find(ValueKey);
+			if (CachedValue == nullptr)
+			{
+				CachedValue = &Values.Add(ValueKey);
+				CachedValue->bHasValue = StyleSet->FindStyleValue(Binding.Value.StyleValueTag, CachedValue->Value);
+			}
+
+			if (!CachedValue->bHasValue)
+			{
+				Result = EMDStyleSetBindingExecutionResult::StyleNotFound;
+			}
+			else if (Target.Property == nullptr || Target.Address == nullptr)
+			{
+				Result = EMDStyleSetBindingExecutionResult::PropertyNotFound;
+			}
+			else
+			{
+				const TTuple<const UMDStyleSet*, const FProperty*> KernelKey(StyleSet, Target.Property);
+				FMDStyleSetConversionKernel* Kernel = Kernels.Find(KernelKey);
+				if (Kernel == nullptr)
+				{
+					Kernel = &Kernels.Add(KernelKey, StyleSet->FindConversionKernel(Target.Property));
+				}
+
+				const FMDStyleValueView& Value = CachedValue->Value;
+				bool bDidSetValue = false;
+				if (*Kernel != nullptr && Value.IsValid() && Value.GetPropertyDesc() == StyleSet->ConversionTable.GetSourceDesc())
+				{
+					bDidSetValue = (*Kernel)(Target.Property, Value.GetMemory(), Target.Address);
+				}
+				else
+				{
+					bDidSetValue = StyleSet->TrySetPropertyValueFromView(Value, Target.Property, Target.Address);
+				}
+
+				Result = bDidSetValue ? EMDStyleSetBindingExecutionResult::Success : EMDStyleSetBindingExecutionResult::CouldNotSetValue;
+			}
+		}
+
+		if (Result == EMDStyleSetBindingExecutionResult::Success)
+		{
+			++NumApplied;
+		}
+
+		if (!OutResults.IsEmpty())
+		{
+			OutResults[BindingIndex] = Result;
+		}
+	}
+
+	return NumApplied;
+}
+
+int32 UMDStyleSet::ApplyBindings(TConstArrayView<FMDStyleSetPropertyBinding> Bindings, UObject* Target)
+{
+	if (!IsValid(Target))
+	{
+		return 0;
+	}
+
+	FMDStyleSetBindingPathResolver Resolver(Target);
+	return ApplyBindings(Bindings, [&Resolver, Bindings](int32 BindingIndex)
+	{
+		return Resolver.Resolve(Bindings[BindingIndex].TargetProperty);
+	});
+}
+
+FMDStyleSetConversionKernel UMDStyleSet::FindConversionKernel(const FProperty* DestProp) const
+{
+	if (ConversionTable.GetSourceDesc() == nullptr)
+	{
+		return nullptr;
+	}
+
+	return ConversionTable.FindKernel(FMDStyleSetTypeKey::FromProperty(DestProp));
+}
+
+bool UMDStyleSet::TrySetPropertyValueFromView(const FMDStyleValueView& Value, const FProperty* DestProp, void* DestPtr) const
+{
+	if (Value.IsValid())
+	{
+		const FPropertyBagPropertyDesc DestDesc = { FMDStyleValue::ValuePropertyName, DestProp };
+		if (DestDesc.CompatibleType(*Value.GetPropertyDesc()))
+		{
+			DestProp->CopyCompleteValue(DestPtr, Value.GetMemory());
+			return true;
+		}
+
+		if (IsValid(TypeHandler))
+		{
+			return TypeHandler->TrySetStyleValue(Value, DestDesc, DestPtr);
+		}
+	}
+
+	return false;
+}
+
+FText UMDStyleSet::GetValueDisplayName(const FGameplayTag& ValueTag) const
+{
+	if (IsValid(TypeHandler))
+	{
+		return TypeHandler->GetValueAsText(this, ValueTag);
+	}
+
+	const FMDStyleValueView Value = GetStyleValueView(ValueTag);
+	if (Value.GetProperty() != nullptr && Value.GetMemory() != nullptr)
+	{
+		FString ValueString;
+		if (Value.GetProperty()->ExportText_Direct(ValueString, Value.GetMemory(), Value.GetMemory(), nullptr, PPF_None))
+		{
+			return FText::FromString(ValueString);
+		}
+	}
+
+	return INVTEXT("Invalid Value");
+}
+
+bool UMDStyleSet::DoesHaveValueWithTag(const FGameplayTag& ValueTag) const
+{
+	FMDStyleValueView Value;
+	return FindStyleValue(ValueTag, Value);
+}
+
+bool UMDStyleSet::FindUnindexedEntry(const FGameplayTag& ValueTag, FMDStyleValueView& OutValue) const
+{
+	TArray<const UMDStyleSet*, TInlineAllocator<4>> VisitedStyleSets;
+	for (const UMDStyleSet* StyleSet = this; IsValid(StyleSet) && !VisitedStyleSets.Contains(StyleSet); StyleSet = StyleSet->BaseStyleSet)
+	{
+		VisitedStyleSets.Add(StyleSet);
+
+		if (StyleSet->FindOwnUnindexedEntry(ValueTag, OutValue))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UMDStyleSet::FindOwnUnindexedEntry(const FGameplayTag& ValueTag, FMDStyleValueView& OutValue) const
+{
+	if (const FMDStyleValue* ValuePtr = StyleEntries.Find(ValueTag))
+	{
+		OutValue = ValuePtr->GetValueView();
+		return true;
+	}
+
+	// Cooked Style Sets keep most of their entries in the packed storage
+	const int32 PackedIndex = PackedEntryTags.IndexOfByKey(ValueTag);
+	if (PackedIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutValue = {};
+
+	const FPropertyBagPropertyDesc* PackedDesc = PackedEntryValues.FindPropertyDescByName(PackedValuesPropertyName);
+	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(PackedDesc != nullptr ? PackedDesc->CachedProperty : nullptr);
+	if (ArrayProperty != nullptr && PackedValueDesc.CachedProperty == ArrayProperty->Inner)
+	{
+		FScriptArrayHelper PackedValues(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(PackedEntryValues.GetValue().GetMemory()));
+		if (PackedValues.IsValidIndex(PackedIndex))
+		{
+			OutValue = { &PackedValueDesc, PackedValues.GetRawPtr(PackedIndex) };
+		}
+	}
+
+	return true;
+}
+
+void UMDStyleSet::UpdatePackedValueDesc()
+{
+	PackedValueDesc = FPropertyBagPropertyDesc();
+
+	const FPropertyBagPropertyDesc* PackedDesc = PackedEntryValues.FindPropertyDescByName(PackedValuesPropertyName);
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(PackedDesc != nullptr ? PackedDesc->CachedProperty : nullptr))
+	{
+		PackedValueDesc = FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, ArrayProperty->Inner);
+		PackedValueDesc.CachedProperty = ArrayProperty->Inner;
+	}
+}
+
+int32 UMDStyleSet::FindParentTagEntryIndex(const FGameplayTag& ValueTag) const
+{
+	{
+		FReadScopeLock ReadLock(ParentTagEntryIndicesLock);
+		if (const int32* EntryIndex = ParentTagEntryIndices.Find(ValueTag))
+		{
+			return *EntryIndex;
+		}
+	}
+
+	int32 EntryIndex = INDEX_NONE;
+	for (FGameplayTag ParentTag = ValueTag.RequestDirectParent(); ParentTag.IsValid() && EntryIndex == INDEX_NONE; ParentTag = ParentTag.RequestDirectParent())
+	{
+		EntryIndex = LookupTable.FindEntryIndex(ParentTag);
+	}
+
+	// Misses are memoized too, so tags that resolve to the fallback value don't walk their parents again
+	FWriteScopeLock WriteLock(ParentTagEntryIndicesLock);
+	ParentTagEntryIndices.Add(ValueTag, EntryIndex);
+	return EntryIndex;
+}
+
+void UMDStyleSet::ResetParentTagEntryIndices()
+{
+	FWriteScopeLock WriteLock(ParentTagEntryIndicesLock);
+	ParentTagEntryIndices.Reset();
+}
+
+void UMDStyleSet::SortEntries()
+{
+#if WITH_EDITOR
+	PreEditChange(GetClass()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(UMDStyleSet, StyleEntries)));
+
+	StyleEntries.KeySort([](const FGameplayTag& A, const FGameplayTag& B)
+	{
+		return !B.IsValid() || (A.IsValid() && A.ToString() < B.ToString());
+	});
+
+	BumpSetVersion();
+	RebuildLookupTable();
 #endif
 }
@@ -3,14 +3,55 @@
 #include "MDStyleSetFunctionLibrary.h"
 
 #include "AssetRegistry/AssetData.h"
-#include "AssetRegistry/AssetRegistryModule.h"
-#include "AssetRegistry/IAssetRegistry.h"
 #include "Blueprint/BlueprintExceptionInfo.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "MDStyleSet.h"
+#include "Util/MDStyleSetConvertibleType.h"
+#include "Util/MDStyleSetConvertibleTypeIndex.h"
 #include "Util/MDStyleSetTypes.h"
 
 #define LOCTEXT_NAMESPACE "MDGameDataBlueprintFunctionLibrary"
 
+namespace MDSSFL
+{
+	bool ValidateGetStyleValueParams(const UObject* Context, FFrame& Stack, const UMDStyleSet* StyleSet, const FProperty* ValueProp, const void* ValuePtr)
+	{
+		if (StyleSet == nullptr)
+		{
+			const FBlueprintExceptionInfo ExceptionInfo(
+				EBlueprintExceptionType::AccessViolation,
+				LOCTEXT("GetValue_MissingStyleSet", "A valid Style Set is required.")
+			);
+			FBlueprintCoreDelegates::ThrowScriptException(Context, Stack, ExceptionInfo);
+			return false;
+		}
+
+		if (ValueProp == nullptr || ValuePtr == nullptr)
+		{
+			const FBlueprintExceptionInfo ExceptionInfo(
+				EBlueprintExceptionType::AccessViolation,
+				LOCTEXT("GetValue_MissingOutputProperty", "Failed to resolve the output parameter for GetStyleValue.")
+			);
+			FBlueprintCoreDelegates::ThrowScriptException(Context, Stack, ExceptionInfo);
+			return false;
+		}
+
+		return true;
+	}
+
+	void ThrowIncompatibleTypesException(const UObject* Context, FFrame& Stack, const UMDStyleSet* StyleSet, const FProperty* ValueProp)
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::AccessViolation,
+			FText::Format(LOCTEXT("GetValue_IncompatibleTypes", "Failed to get Style Value ({0}), it may not exist or it's not compatible with type ({1}).")
+				, StyleSet->GetDisplayName()
+				, ValueProp->GetClass()->GetDisplayNameText())
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(Context, Stack, ExceptionInfo);
+	}
+}
+
 void UMDStyleSetFunctionLibrary::GetStyleValue(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag, int32& OutValue)
 {
 	checkNoEntry();
@@ -27,124 +68,141 @@ DEFINE_FUNCTION(UMDStyleSetFunctionLibrary::execGetStyleValue)
 
 	P_FINISH;
 
-	if (StyleSet == nullptr)
+	if (!MDSSFL::ValidateGetStyleValueParams(P_THIS, Stack, StyleSet, ValueProp, ValuePtr))
 	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::AccessViolation,
-			LOCTEXT("GetValue_MissingStyleSet", "A valid Style Set is required.")
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
 		return;
 	}
 
-	if (ValueProp == nullptr || ValuePtr == nullptr)
+	bool bResult = false;
+	P_NATIVE_BEGIN
+	bResult = StyleSet->TrySetPropertyValue(StyleTag, ValueProp, ValuePtr);
+	P_NATIVE_END
+
+	if (!bResult)
+	{
+		MDSSFL::ThrowIncompatibleTypesException(P_THIS, Stack, StyleSet, ValueProp);
+	}
+}
+
+void UMDStyleSetFunctionLibrary::GetStyleValueCached(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag, FMDStyleSetValueCache& Cache, int32& OutValue)
+{
+	checkNoEntry();
+}
+
+DEFINE_FUNCTION(UMDStyleSetFunctionLibrary::execGetStyleValueCached)
+{
+	P_GET_OBJECT(UMDStyleSet, StyleSet);
+	P_GET_STRUCT_REF(FGameplayTag, StyleTag);
+	P_GET_STRUCT_REF(FMDStyleSetValueCache, Cache);
+
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	const FProperty* ValueProp = Stack.MostRecentProperty;
+	void* ValuePtr = Stack.MostRecentPropertyAddress;
+
+	P_FINISH;
+
+	if (!MDSSFL::ValidateGetStyleValueParams(P_THIS, Stack, StyleSet, ValueProp, ValuePtr))
 	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::AccessViolation,
-			LOCTEXT("GetValue_MissingOutputProperty", "Failed to resolve the output parameter for GetStyleValue.")
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
 		return;
 	}
 
 	bool bResult = false;
 	P_NATIVE_BEGIN
-	bResult = StyleSet->TrySetPropertyValue(StyleTag, ValueProp, ValuePtr);
+	bResult = StyleSet->TrySetPropertyValue(StyleTag, ValueProp, ValuePtr, Cache);
 	P_NATIVE_END
 
 	if (!bResult)
 	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::AccessViolation,
-			FText::Format(LOCTEXT("GetValue_IncompatibleTypes", "Failed to get Style Value ({0}), it may not exist or it's not compatible with type ({1}).")
-				, StyleSet->GetDisplayName()
-				, ValueProp->GetClass()->GetDisplayNameText())
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		MDSSFL::ThrowIncompatibleTypesException(P_THIS, Stack, StyleSet, ValueProp);
 	}
 }
 
-TTuple<FPropertyBagPropertyDesc, const uint8*> UMDStyleSetFunctionLibrary::GetStyleSetValue(const FMDStyleSetValueReference& ValueReference)
+FMDStyleValueView UMDStyleSetFunctionLibrary::GetStyleSetValueView(const FMDStyleSetValueReference& ValueReference)
 {
 	if (UMDStyleSet* StyleSet = ValueReference.StyleSet)
 	{
-		return StyleSet->GetStyleValue(ValueReference.StyleValueTag);
+		return StyleSet->GetStyleValueView(ValueReference.StyleValueTag);
 	}
 
 	return {};
 }
 
-bool UMDStyleSetFunctionLibrary::HasConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc)
+FMDStyleValueView UMDStyleSetFunctionLibrary::GetStyleSetValueView(const FMDStyleSetSoftValueReference& ValueReference)
 {
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	// The soft pointer caches the resolved Style Set until it's unloaded
+	if (const UMDStyleSet* StyleSet = ValueReference.StyleSet.Get())
+	{
+		return StyleSet->GetStyleValueView(ValueReference.StyleValueTag);
+	}
 
-	TArray<FAssetData> Assets;
-	if (AssetRegistry.GetAssetsByClass(UMDStyleSet::StaticClass()->GetClassPathName(), Assets, true))
+	return {};
+}
+
+TSharedPtr<FStreamableHandle> UMDStyleSetFunctionLibrary::GetStyleValueAsync(const FMDStyleSetSoftValueReference& ValueReference, TFunction<void(const FMDStyleValueView&)>&& OnLoaded)
+{
+	if (ValueReference.StyleSet.IsNull())
 	{
-		for (const FAssetData& Asset : Assets)
-		{
-			TArray<FPropertyBagPropertyDesc> ConvertibleTypes = GetConvertibleTypes(Asset);
-			for (const FPropertyBagPropertyDesc& ConvertibleType : ConvertibleTypes)
-			{
-				if (ConvertibleType.CompatibleType(Desc))
-				{
-					return true;
-				}
-			}
-		}
+		OnLoaded({});
+		return nullptr;
 	}
 
-	return false;
+	if (!UAssetManager::IsInitialized())
+	{
+		ValueReference.StyleSet.LoadSynchronous();
+		OnLoaded(GetStyleSetValueView(ValueReference));
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(ValueReference.StyleSet.ToSoftObjectPath(), FStreamableDelegate::CreateLambda([ValueReference, OnLoaded = MoveTemp(OnLoaded)]()
+	{
+		OnLoaded(GetStyleSetValueView(ValueReference));
+	}));
+}
+
+TTuple<FPropertyBagPropertyDesc, const uint8*> UMDStyleSetFunctionLibrary::GetStyleSetValue(const FMDStyleSetValueReference& ValueReference)
+{
+	return GetStyleSetValueView(ValueReference).ToTuple();
+}
+
+bool UMDStyleSetFunctionLibrary::HasConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc)
+{
+	return FMDStyleSetConvertibleTypeIndex::Get().HasConvertibleStyleSets(Desc);
 }
 
 TArray<UMDStyleSet*> UMDStyleSetFunctionLibrary::GetConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc)
 {
 	TArray<UMDStyleSet*> Result;
 
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
-
-	TArray<FAssetData> Assets;
-	if (AssetRegistry.GetAssetsByClass(UMDStyleSet::StaticClass()->GetClassPathName(), Assets, true))
+	for (const FAssetData& Asset : GetConvertibleStyleSetAssets(Desc))
 	{
-		for (const FAssetData& Asset : Assets)
+		if (UMDStyleSet* StyleSet = Cast<UMDStyleSet>(Asset.GetAsset()))
 		{
-			TArray<FPropertyBagPropertyDesc> ConvertibleTypes = GetConvertibleTypes(Asset);
-			for (const FPropertyBagPropertyDesc& ConvertibleType : ConvertibleTypes)
-			{
-				if (ConvertibleType.CompatibleType(Desc))
-				{
-					if (FPackageName::GetPackageMountPoint(Asset.PackageName.ToString()) != NAME_None)
-					{
-						if (UMDStyleSet* StyleSet = Cast<UMDStyleSet>(Asset.GetAsset()))
-						{
-							Result.Add(StyleSet);
-							break;
-						}
-					}
-				}
-			}
+			Result.Add(StyleSet);
 		}
 	}
 
 	return Result;
 }
 
+TArray<FAssetData> UMDStyleSetFunctionLibrary::GetConvertibleStyleSetAssets(const FPropertyBagPropertyDesc& Desc)
+{
+	TArray<FAssetData> Result = FMDStyleSetConvertibleTypeIndex::Get().GetConvertibleStyleSets(Desc);
+
+	Result.RemoveAllSwap([](const FAssetData& Asset)
+	{
+		return FPackageName::GetPackageMountPoint(Asset.PackageName.ToString()) == NAME_None;
+	});
+
+	return Result;
+}
+
 TArray<FPropertyBagPropertyDesc> UMDStyleSetFunctionLibrary::GetConvertibleTypes(const FAssetData& Asset)
 {
 	TArray<FPropertyBagPropertyDesc> Result;
 
-	FString ConvertibleTypesString;
-	if (Asset.GetTagValue(UMDStyleSet::ConvertibleTypesAssetTagName, ConvertibleTypesString))
+	for (const FMDStyleSetConvertibleType& Type : FMDStyleSetConvertibleType::FromAssetData(Asset))
 	{
-		TArray<FString> ConvertibleTypeStrings;
-		ConvertibleTypesString.ParseIntoArrayLines(ConvertibleTypeStrings);
-
-		for (const FString& ConvertibleTypeString : ConvertibleTypeStrings)
-		{
-			FPropertyBagPropertyDesc ConvertibleTypeDesc;
-			FPropertyBagPropertyDesc::StaticStruct()->ImportText(*ConvertibleTypeString, &ConvertibleTypeDesc, nullptr, PPF_None, nullptr, FPropertyBagPropertyDesc::StaticStruct()->GetName());
-			Result.Add(MoveTemp(ConvertibleTypeDesc));
-		}
+		Result.Add(Type.ToDesc());
 	}
 
 	return Result;
@@ -2,14 +2,19 @@
 
 #include "MDStyleSets.h"
 
+#include "Util/MDStyleSetConvertibleTypeIndex.h"
+
 #define LOCTEXT_NAMESPACE "FMDStyleSetsModule"
 
+LLM_DEFINE_TAG(MDStyleSets);
+
 void FMDStyleSetsModule::StartupModule()
 {
 }
 
 void FMDStyleSetsModule::ShutdownModule()
 {
+	FMDStyleSetConvertibleTypeIndex::TearDown();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,354 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Subsystems/MDStyleSetThemeSubsystem.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Extensions/MDStyleSetWidgetClassExtension.h"
+#include "HAL/IConsoleManager.h"
+#include "MDStyleSet.h"
+#include "MDStyleSets.h"
+
+namespace MDSSTS
+{
+	static TAutoConsoleVariable<float> CVarThemeApplyBudgetMs(
+		TEXT("MDStyleSets.ThemeApplyBudgetMs"),
+		2.f,
+		TEXT("Time in milliseconds spent re-applying style bindings to live widgets each frame after a theme change, 0 applies them all in a single frame."));
+
+	bool HasValueChanged(const UMDStyleSet* PreviousStyleSet, const UMDStyleSet* StyleSet, const FGameplayTag& Tag)
+	{
+		const FMDStyleValueView PreviousValue = IsValid(PreviousStyleSet) ? PreviousStyleSet->GetStyleValueView(Tag) : FMDStyleValueView();
+		const FMDStyleValueView Value = IsValid(StyleSet) ? StyleSet->GetStyleValueView(Tag) : FMDStyleValueView();
+		if (!PreviousValue.IsValid() || !Value.IsValid())
+		{
+			return PreviousValue.IsValid() != Value.IsValid();
+		}
+
+		if (!FMDStyleSetLookupTable::IsSameValueType(*PreviousValue.GetPropertyDesc(), *Value.GetPropertyDesc()))
+		{
+			return true;
+		}
+
+		return !Value.GetProperty()->Identical(PreviousValue.GetMemory(), Value.GetMemory());
+	}
+
+	// Sets the value into a temporary first so the target is only written to if its value is different
+	bool TrySetChangedPropertyValue(const UMDStyleSet* StyleSet, const FGameplayTag& Tag, const FMDStyleSetBindingTarget& Target)
+	{
+		const FProperty* Property = Target.Property;
+		void* TempValue = FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+		Property->InitializeValue(TempValue);
+
+		const bool bHasChanged = StyleSet->TrySetPropertyValue(Tag, Property, TempValue) && !Property->Identical(TempValue, Target.Address);
+		if (bHasChanged)
+		{
+			Property->CopySingleValue(Target.Address, TempValue);
+		}
+
+		Property->DestroyValue(TempValue);
+		FMemory::Free(TempValue);
+
+		return bHasChanged;
+	}
+}
+
+void UMDStyleSetThemeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+#if WITH_EDITOR
+	StyleSetEditedHandle = UMDStyleSet::OnStyleSetEdited.AddUObject(this, &UMDStyleSetThemeSubsystem::OnStyleSetEdited);
+#endif
+}
+
+void UMDStyleSetThemeSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	UMDStyleSet::OnStyleSetEdited.Remove(StyleSetEditedHandle);
+	StyleSetEditedHandle.Reset();
+#endif
+
+	if (ApplyTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ApplyTickerHandle);
+		ApplyTickerHandle.Reset();
+	}
+
+	PendingWidgets.Reset();
+	NextPendingWidgetIndex = 0;
+	RegisteredClasses.Reset();
+	StyleSetOverrides.Reset();
+
+	Super::Deinitialize();
+}
+
+void UMDStyleSetThemeSubsystem::SetStyleSetOverride(UMDStyleSet* StyleSet, UMDStyleSet* OverrideStyleSet)
+{
+	if (!IsValid(StyleSet))
+	{
+		return;
+	}
+
+	UMDStyleSet* PreviousStyleSet = ResolveStyleSet(StyleSet);
+
+	if (!IsValid(OverrideStyleSet) || OverrideStyleSet == StyleSet)
+	{
+		StyleSetOverrides.Remove(StyleSet);
+	}
+	else
+	{
+		StyleSetOverrides.Add(StyleSet, OverrideStyleSet);
+	}
+
+	if (PreviousStyleSet != ResolveStyleSet(StyleSet))
+	{
+		OnStyleSetResolveChanged(StyleSet, PreviousStyleSet);
+	}
+}
+
+void UMDStyleSetThemeSubsystem::ClearStyleSetOverride(UMDStyleSet* StyleSet)
+{
+	SetStyleSetOverride(StyleSet, nullptr);
+}
+
+void UMDStyleSetThemeSubsystem::ClearAllStyleSetOverrides()
+{
+	TArray<TObjectPtr<UMDStyleSet>> StyleSets;
+	StyleSetOverrides.GenerateKeyArray(StyleSets);
+
+	for (UMDStyleSet* StyleSet : StyleSets)
+	{
+		ClearStyleSetOverride(StyleSet);
+	}
+}
+
+UMDStyleSet* UMDStyleSetThemeSubsystem::ResolveStyleSet(UMDStyleSet* StyleSet) const
+{
+	if (const TObjectPtr<UMDStyleSet>* OverrideStyleSet = StyleSetOverrides.Find(StyleSet))
+	{
+		return *OverrideStyleSet;
+	}
+
+	return StyleSet;
+}
+
+void UMDStyleSetThemeSubsystem::RegisterWidget(UUserWidget* Widget, const UMDStyleSetWidgetClassExtension* Extension)
+{
+	LLM_SCOPE_BYTAG(MDStyleSets);
+
+	if (!IsValid(Widget) || !IsValid(Extension))
+	{
+		return;
+	}
+
+	FRegisteredClass& RegisteredClass = RegisteredClasses.FindOrAdd(FObjectKey(Extension));
+	RegisteredClass.Extension = Extension;
+
+	// Widgets aren't unregistered, destroyed ones are pruned whenever the set doubles in size so it stays bounded when widgets are created often
+	if (RegisteredClass.Widgets.Num() >= FMath::Max(RegisteredClass.NumWidgetsAfterPrune * 2, 16))
+	{
+		PruneWidgets(RegisteredClass);
+	}
+
+	RegisteredClass.Widgets.Add(Widget);
+
+	// The bindings were baked with the original Style Sets, new widgets need to catch up with the current theme right away
+	if (!StyleSetOverrides.IsEmpty())
+	{
+		TArray<int32> BindingIndices;
+		const TArray<FMDStyleSetPropertyBinding>& Bindings = Extension->GetBindings();
+		for (int32 i = 0; i < Bindings.Num(); ++i)
+		{
+			if (StyleSetOverrides.Contains(Bindings[i].Value.StyleSet))
+			{
+				BindingIndices.Add(i);
+			}
+		}
+
+		ApplyBindings(Widget, *Extension, BindingIndices);
+	}
+}
+
+void UMDStyleSetThemeSubsystem::PruneWidgets(FRegisteredClass& RegisteredClass)
+{
+	for (auto It = RegisteredClass.Widgets.CreateIterator(); It; ++It)
+	{
+		if (!It->IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	RegisteredClass.NumWidgetsAfterPrune = RegisteredClass.Widgets.Num();
+}
+
+void UMDStyleSetThemeSubsystem::OnStyleSetResolveChanged(UMDStyleSet* StyleSet, const UMDStyleSet* PreviousStyleSet)
+{
+	const UMDStyleSet* CurrentStyleSet = ResolveStyleSet(StyleSet);
+
+	// Many widget classes bind to the same styles, only compare each value once
+	TMap<FGameplayTag, bool> ChangedTags;
+
+	for (auto It = RegisteredClasses.CreateIterator(); It; ++It)
+	{
+		FRegisteredClass& RegisteredClass = It->Value;
+		PruneWidgets(RegisteredClass);
+
+		const UMDStyleSetWidgetClassExtension* Extension = RegisteredClass.Extension.Get();
+		if (Extension == nullptr || RegisteredClass.Widgets.IsEmpty())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		TArray<int32> BindingIndices;
+		const TArray<FMDStyleSetPropertyBinding>& Bindings = Extension->GetBindings();
+		for (int32 i = 0; i < Bindings.Num(); ++i)
+		{
+			const FMDStyleSetValueReference& Value = Bindings[i].Value;
+			if (Value.StyleSet != StyleSet)
+			{
+				continue;
+			}
+
+			const bool* bHasChanged = ChangedTags.Find(Value.StyleValueTag);
+			if (bHasChanged == nullptr)
+			{
+				bHasChanged = &ChangedTags.Add(Value.StyleValueTag, MDSSTS::HasValueChanged(PreviousStyleSet, CurrentStyleSet, Value.StyleValueTag));
+			}
+
+			if (*bHasChanged)
+			{
+				BindingIndices.Add(i);
+			}
+		}
+
+		if (!BindingIndices.IsEmpty())
+		{
+			for (const TWeakObjectPtr<UUserWidget>& Widget : RegisteredClass.Widgets)
+			{
+				PendingWidgets.Add({ Widget, Extension, BindingIndices });
+			}
+		}
+	}
+
+	if (!PendingWidgets.IsEmpty() && !ApplyTickerHandle.IsValid())
+	{
+		ApplyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMDStyleSetThemeSubsystem::ApplyPendingWidgets));
+	}
+}
+
+void UMDStyleSetThemeSubsystem::ApplyBindings(UUserWidget* Widget, const UMDStyleSetWidgetClassExtension& Extension, TConstArrayView<int32> BindingIndices, bool bOnlyChangedValues) const
+{
+	TArray<UWidget*, TInlineAllocator<8>> ChangedWidgets;
+
+	const TArray<FMDStyleSetPropertyBinding>& Bindings = Extension.GetBindings();
+	for (const int32 BindingIndex : BindingIndices)
+	{
+		if (!Bindings.IsValidIndex(BindingIndex))
+		{
+			continue;
+		}
+
+		const FMDStyleSetPropertyBinding& Binding = Bindings[BindingIndex];
+		const UMDStyleSet* StyleSet = ResolveStyleSet(Binding.Value.StyleSet);
+		if (!IsValid(StyleSet))
+		{
+			continue;
+		}
+
+		UWidget* TargetWidget = nullptr;
+		const FMDStyleSetBindingTarget Target = Extension.ResolveBindingTarget(Widget, BindingIndex, TargetWidget);
+		if (Target.Property == nullptr)
+		{
+			continue;
+		}
+
+		if (bOnlyChangedValues)
+		{
+			if (MDSSTS::TrySetChangedPropertyValue(StyleSet, Binding.Value.StyleValueTag, Target))
+			{
+				ChangedWidgets.AddUnique(TargetWidget);
+			}
+		}
+		else if (StyleSet->TrySetPropertyValue(Binding.Value.StyleValueTag, Target.Property, Target.Address))
+		{
+			ChangedWidgets.AddUnique(TargetWidget);
+		}
+	}
+
+	// Push the new values to the underlying slate widgets
+	for (UWidget* ChangedWidget : ChangedWidgets)
+	{
+		if (IsValid(ChangedWidget))
+		{
+			ChangedWidget->SynchronizeProperties();
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UMDStyleSetThemeSubsystem::OnStyleSetEdited(UMDStyleSet* StyleSet)
+{
+	for (auto It = RegisteredClasses.CreateIterator(); It; ++It)
+	{
+		FRegisteredClass& RegisteredClass = It->Value;
+		PruneWidgets(RegisteredClass);
+
+		const UMDStyleSetWidgetClassExtension* Extension = RegisteredClass.Extension.Get();
+		if (Extension == nullptr || RegisteredClass.Widgets.IsEmpty())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Style Sets using the edited one as a base can also have new values
+		TArray<int32> BindingIndices;
+		const TArray<FMDStyleSetPropertyBinding>& Bindings = Extension->GetBindings();
+		for (int32 i = 0; i < Bindings.Num(); ++i)
+		{
+			const UMDStyleSet* BoundStyleSet = ResolveStyleSet(Bindings[i].Value.StyleSet);
+			if (IsValid(BoundStyleSet) && BoundStyleSet->IsOrInheritsFrom(StyleSet))
+			{
+				BindingIndices.Add(i);
+			}
+		}
+
+		if (!BindingIndices.IsEmpty())
+		{
+			for (const TWeakObjectPtr<UUserWidget>& Widget : RegisteredClass.Widgets)
+			{
+				ApplyBindings(Widget.Get(), *Extension, BindingIndices, true);
+			}
+		}
+	}
+}
+#endif
+
+bool UMDStyleSetThemeSubsystem::ApplyPendingWidgets(float DeltaTime)
+{
+	const float BudgetMs = MDSSTS::CVarThemeApplyBudgetMs.GetValueOnGameThread();
+	const double EndTime = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+
+	while (NextPendingWidgetIndex < PendingWidgets.Num())
+	{
+		const FPendingWidget& PendingWidget = PendingWidgets[NextPendingWidgetIndex++];
+		UUserWidget* Widget = PendingWidget.Widget.Get();
+		const UMDStyleSetWidgetClassExtension* Extension = PendingWidget.Extension.Get();
+		if (Widget != nullptr && Extension != nullptr)
+		{
+			ApplyBindings(Widget, *Extension, PendingWidget.BindingIndices);
+		}
+
+		if (BudgetMs > 0.f && FPlatformTime::Seconds() >= EndTime)
+		{
+			return true;
+		}
+	}
+
+	PendingWidgets.Reset();
+	NextPendingWidgetIndex = 0;
+	ApplyTickerHandle.Reset();
+	return false;
+}
@@ -22,6 +22,11 @@ void SMDStyleSetPreviewUWidgetWrapper::Construct(const FArguments& InArgs, UWidg
 	}
 }
 
+bool UMDStyleSetTypeHandlerBase::TrySetStyleValue(const FMDStyleValueView& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const
+{
+	return TrySetValue(Value.ToTuple(), DestDesc, DestPtr);
+}
+
 TSharedRef<SWidget> UMDStyleSetTypeHandlerBase::CreateValuePreviewWidget(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag) const
 {
 	if (IsValid(PreviewWidgetClass))
@@ -48,15 +53,15 @@ FText UMDStyleSetTypeHandlerBase::GetValueAsText_Implementation(const UMDStyleSe
 		return INVTEXT("Invalid Style Set");
 	}
 
-	TTuple<FPropertyBagPropertyDesc, const uint8*> StyleValue = StyleSet->GetStyleValue(StyleTag);
-	const FProperty* Property = StyleValue.Key.CachedProperty;
-	if (Property == nullptr || StyleValue.Value == nullptr)
+	const FMDStyleValueView StyleValue = StyleSet->GetStyleValueView(StyleTag);
+	const FProperty* Property = StyleValue.GetProperty();
+	if (Property == nullptr || StyleValue.GetMemory() == nullptr)
 	{
 		return INVTEXT("Invalid Style Value");
 	}
 
 	FString OutStringValue;
-	if (!Property->ExportText_Direct(OutStringValue, StyleValue.Value, StyleValue.Value, nullptr, PPF_None))
+	if (!Property->ExportText_Direct(OutStringValue, StyleValue.GetMemory(), StyleValue.GetMemory(), nullptr, PPF_None))
 	{
 		return INVTEXT("Invalid Style Value");
 	}
@@ -17,87 +17,150 @@ namespace MDSSTHC
 			return {};
 		}
 
-		TTuple<FPropertyBagPropertyDesc, const uint8*> StyleValue = StyleSet->GetStyleValue(StyleTag);
-		if (StyleValue.Value == nullptr)
+		const FMDStyleValueView StyleValue = StyleSet->GetStyleValueView(StyleTag);
+		if (!StyleValue.IsValid())
 		{
 			return {};
 		}
 
-		if (StyleValue.Key.ValueTypeObject == TBaseStructure<FLinearColor>::Get())
+		if (StyleValue.GetValueTypeObject() == TBaseStructure<FLinearColor>::Get())
 		{
-			return *reinterpret_cast<const FLinearColor*>(StyleValue.Value);
+			return StyleValue.Get<FLinearColor>();
 		}
-		else if (StyleValue.Key.ValueTypeObject == TBaseStructure<FColor>::Get())
+		else if (StyleValue.GetValueTypeObject() == TBaseStructure<FColor>::Get())
 		{
-			return *reinterpret_cast<const FColor*>(StyleValue.Value);
+			return StyleValue.Get<FColor>();
 		}
-		else if (StyleValue.Key.ValueTypeObject == TBaseStructure<FSlateColor>::Get())
+		else if (StyleValue.GetValueTypeObject() == TBaseStructure<FSlateColor>::Get())
 		{
-			return *reinterpret_cast<const FSlateColor*>(StyleValue.Value);
+			return StyleValue.Get<FSlateColor>();
 		}
 
 		return {};
 	}
-}
 
-void UMDStyleSetTypeHandler_Color::GetConvertibleTypes(TArray<FPropertyBagPropertyDesc>& OutConvertibleTypes) const
-{
-	Super::GetConvertibleTypes(OutConvertibleTypes);
+	bool ReadColor(const FLinearColor& Source, FLinearColor& OutColor)
+	{
+		OutColor = Source;
+		return true;
+	}
 
-	OutConvertibleTypes.Add(FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, EPropertyBagPropertyType::Struct, TBaseStructure<FLinearColor>::Get()));
-	OutConvertibleTypes.Add(FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, EPropertyBagPropertyType::Struct, TBaseStructure<FColor>::Get()));
-	OutConvertibleTypes.Add(FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, EPropertyBagPropertyType::Struct, TBaseStructure<FSlateColor>::Get()));
-}
+	bool ReadColor(const FColor& Source, FLinearColor& OutColor)
+	{
+		OutColor = Source;
+		return true;
+	}
 
-bool UMDStyleSetTypeHandler_Color::TrySetValue(const TTuple<FPropertyBagPropertyDesc, const uint8*>& Value, const FPropertyBagPropertyDesc& DestDesc, void* DescPtr) const
-{
-	static const TSet<const UObject*> ColorStructs = { TBaseStructure<FLinearColor>::Get(), TBaseStructure<FColor>::Get(), TBaseStructure<FSlateColor>::Get() };
-	if (Value.Value == nullptr || Value.Key.ValueType != EPropertyBagPropertyType::Struct || !ColorStructs.Contains(Value.Key.ValueTypeObject))
+	bool ReadColor(const FSlateColor& Source, FLinearColor& OutColor)
 	{
+		if (Source.IsColorSpecified())
+		{
+			OutColor = Source.GetSpecifiedColor();
+			return true;
+		}
+
 		return false;
 	}
 
-	TOptional<FLinearColor> SourceColor;
-	if (Value.Key.ValueTypeObject == TBaseStructure<FLinearColor>::Get())
+	void WriteColor(const FLinearColor& Color, FLinearColor& OutDest)
+	{
+		OutDest = Color;
+	}
+
+	void WriteColor(const FLinearColor& Color, FColor& OutDest)
 	{
-		const FLinearColor* Color = reinterpret_cast<const FLinearColor*>(Value.Value);
-		SourceColor = *Color;
+		OutDest = Color.ToFColorSRGB();
 	}
-	else if (Value.Key.ValueTypeObject == TBaseStructure<FColor>::Get())
+
+	void WriteColor(const FLinearColor& Color, FSlateColor& OutDest)
 	{
-		const FColor* Color = reinterpret_cast<const FColor*>(Value.Value);
-		SourceColor = *Color;
+		OutDest = Color;
 	}
-	else if (Value.Key.ValueTypeObject == TBaseStructure<FSlateColor>::Get())
+
+	template<typename SourceType, typename DestType>
+	bool ConvertColor(const FProperty* DestProp, const uint8* Source, void* Dest)
 	{
-		const FSlateColor* Color = reinterpret_cast<const FSlateColor*>(Value.Value);
-		if (Color->IsColorSpecified())
+		FLinearColor Color;
+		if (!ReadColor(*reinterpret_cast<const SourceType*>(Source), Color))
 		{
-			SourceColor = Color->GetSpecifiedColor();
-			return true;
+			return false;
 		}
+
+		WriteColor(Color, *static_cast<DestType*>(Dest));
+		return true;
 	}
 
-	if (SourceColor.IsSet())
+	template<typename SourceType>
+	FMDStyleSetConversionKernel GetKernel(const FMDStyleSetTypeKey& DestType)
 	{
-		if (DestDesc.ValueTypeObject == TBaseStructure<FLinearColor>::Get())
+		if (DestType.ValueType != EPropertyBagPropertyType::Struct || DestType.ContainerType != EPropertyBagContainerType::None)
+		{
+			return nullptr;
+		}
+
+		if (DestType.ValueTypeObject == TBaseStructure<FLinearColor>::Get())
 		{
-			FLinearColor* DestColor = static_cast<FLinearColor*>(DescPtr);
-			*DestColor = SourceColor.GetValue();
+			return &ConvertColor<SourceType, FLinearColor>;
 		}
-		else if (DestDesc.ValueTypeObject == TBaseStructure<FColor>::Get())
+		else if (DestType.ValueTypeObject == TBaseStructure<FColor>::Get())
 		{
-			FColor* DestColor = static_cast<FColor*>(DescPtr);
-			*DestColor = SourceColor.GetValue().ToFColorSRGB();
+			return &ConvertColor<SourceType, FColor>;
 		}
-		else if (DestDesc.ValueTypeObject == TBaseStructure<FSlateColor>::Get())
+		else if (DestType.ValueTypeObject == TBaseStructure<FSlateColor>::Get())
 		{
-			FSlateColor* DestColor = static_cast<FSlateColor*>(DescPtr);
-			*DestColor = SourceColor.GetValue();
+			return &ConvertColor<SourceType, FSlateColor>;
 		}
+
+		return nullptr;
 	}
+}
 
-	return false;
+void UMDStyleSetTypeHandler_Color::GetConvertibleTypes(TArray<FPropertyBagPropertyDesc>& OutConvertibleTypes) const
+{
+	Super::GetConvertibleTypes(OutConvertibleTypes);
+
+	OutConvertibleTypes.Add(FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, EPropertyBagPropertyType::Struct, TBaseStructure<FLinearColor>::Get()));
+	OutConvertibleTypes.Add(FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, EPropertyBagPropertyType::Struct, TBaseStructure<FColor>::Get()));
+	OutConvertibleTypes.Add(FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, EPropertyBagPropertyType::Struct, TBaseStructure<FSlateColor>::Get()));
+}
+
+FMDStyleSetConversionKernel UMDStyleSetTypeHandler_Color::GetConversionKernel(const FMDStyleSetTypeKey& SourceType, const FMDStyleSetTypeKey& DestType) const
+{
+	if (SourceType.ValueType != EPropertyBagPropertyType::Struct || SourceType.ContainerType != EPropertyBagContainerType::None)
+	{
+		return nullptr;
+	}
+
+	if (SourceType.ValueTypeObject == TBaseStructure<FLinearColor>::Get())
+	{
+		return MDSSTHC::GetKernel<FLinearColor>(DestType);
+	}
+	else if (SourceType.ValueTypeObject == TBaseStructure<FColor>::Get())
+	{
+		return MDSSTHC::GetKernel<FColor>(DestType);
+	}
+	else if (SourceType.ValueTypeObject == TBaseStructure<FSlateColor>::Get())
+	{
+		return MDSSTHC::GetKernel<FSlateColor>(DestType);
+	}
+
+	return nullptr;
+}
+
+bool UMDStyleSetTypeHandler_Color::TrySetStyleValue(const FMDStyleValueView& Value, const FPropertyBagPropertyDesc& DestDesc, void* DescPtr) const
+{
+	if (!Value.IsValid())
+	{
+		return false;
+	}
+
+	const FMDStyleSetConversionKernel Kernel = GetConversionKernel(FMDStyleSetTypeKey::FromDesc(*Value.GetPropertyDesc()), FMDStyleSetTypeKey::FromDesc(DestDesc));
+	return Kernel != nullptr && Kernel(DestDesc.CachedProperty, Value.GetMemory(), DescPtr);
+}
+
+bool UMDStyleSetTypeHandler_Color::TrySetValue(const TTuple<FPropertyBagPropertyDesc, const uint8*>& Value, const FPropertyBagPropertyDesc& DestDesc, void* DescPtr) const
+{
+	return TrySetStyleValue(FMDStyleValueView(&Value.Key, Value.Value), DestDesc, DescPtr);
 }
 
 TSharedRef<SWidget> UMDStyleSetTypeHandler_Color::CreateValuePreviewWidget(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag) const
@@ -119,22 +182,22 @@ FText UMDStyleSetTypeHandler_Color::GetValueAsText_Implementation(const UMDStyle
 {
 	if (IsValid(StyleSet))
 	{
-		TTuple<FPropertyBagPropertyDesc, const uint8*> StyleValue = StyleSet->GetStyleValue(StyleTag);
-		if (StyleValue.Value != nullptr)
+		const FMDStyleValueView StyleValue = StyleSet->GetStyleValueView(StyleTag);
+		if (StyleValue.IsValid())
 		{
-			if (StyleValue.Key.ValueTypeObject == TBaseStructure<FLinearColor>::Get())
+			if (StyleValue.GetValueTypeObject() == TBaseStructure<FLinearColor>::Get())
 			{
-				const FLinearColor* Color = reinterpret_cast<const FLinearColor*>(StyleValue.Value);
+				const FLinearColor* Color = &StyleValue.Get<FLinearColor>();
 				return FText::FromString(Color->ToString());
 			}
-			else if (StyleValue.Key.ValueTypeObject == TBaseStructure<FColor>::Get())
+			else if (StyleValue.GetValueTypeObject() == TBaseStructure<FColor>::Get())
 			{
-				const FColor* Color = reinterpret_cast<const FColor*>(StyleValue.Value);
+				const FColor* Color = &StyleValue.Get<FColor>();
 				return FText::FromString(Color->ToString());
 			}
-			else if (StyleValue.Key.ValueTypeObject == TBaseStructure<FSlateColor>::Get())
+			else if (StyleValue.GetValueTypeObject() == TBaseStructure<FSlateColor>::Get())
 			{
-				const FSlateColor* Color = reinterpret_cast<const FSlateColor*>(StyleValue.Value);
+				const FSlateColor* Color = &StyleValue.Get<FSlateColor>();
 				if (Color->IsColorSpecified())
 				{
 					return FText::FromString(Color->GetSpecifiedColor().ToString());
@@ -5,6 +5,38 @@
 
 #include "MDStyleSet.h"
 
+namespace MDSSTHN
+{
+	template<typename SourceType, typename DestType>
+	bool ConvertNumber(const FProperty* DestProp, const uint8* Source, void* Dest)
+	{
+		*static_cast<DestType*>(Dest) = static_cast<DestType>(*reinterpret_cast<const SourceType*>(Source));
+		return true;
+	}
+
+	template<typename SourceType>
+	FMDStyleSetConversionKernel GetKernel(EPropertyBagPropertyType DestType)
+	{
+		switch (DestType)
+		{
+		case EPropertyBagPropertyType::Double:
+			return &ConvertNumber<SourceType, double>;
+		case EPropertyBagPropertyType::Float:
+			return &ConvertNumber<SourceType, float>;
+		case EPropertyBagPropertyType::Int32:
+			return &ConvertNumber<SourceType, int32>;
+		case EPropertyBagPropertyType::Int64:
+			return &ConvertNumber<SourceType, int64>;
+		case EPropertyBagPropertyType::UInt32:
+			return &ConvertNumber<SourceType, uint32>;
+		case EPropertyBagPropertyType::UInt64:
+			return &ConvertNumber<SourceType, uint64>;
+		default:
+			return nullptr;
+		}
+	}
+}
+
 void UMDStyleSetTypeHandler_Numeric::GetConvertibleTypes(TArray<FPropertyBagPropertyDesc>& OutConvertibleTypes) const
 {
 	Super::GetConvertibleTypes(OutConvertibleTypes);
@@ -17,112 +49,46 @@ void UMDStyleSetTypeHandler_Numeric::GetConvertibleTypes(TArray<FPropertyBagProp
 	OutConvertibleTypes.Add(FPropertyBagPropertyDesc(FMDStyleValue::ValuePropertyName, EPropertyBagPropertyType::UInt64));
 }
 
-bool UMDStyleSetTypeHandler_Numeric::TrySetValue(const TTuple<FPropertyBagPropertyDesc, const uint8*>& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const
+FMDStyleSetConversionKernel UMDStyleSetTypeHandler_Numeric::GetConversionKernel(const FMDStyleSetTypeKey& SourceType, const FMDStyleSetTypeKey& DestType) const
 {
-	static const TSet<EPropertyBagPropertyType> NumericTypes = {
-		EPropertyBagPropertyType::Double,
-		EPropertyBagPropertyType::Float,
-		EPropertyBagPropertyType::Int32,
-		EPropertyBagPropertyType::Int64,
-		EPropertyBagPropertyType::UInt32,
-		EPropertyBagPropertyType::UInt64
-	};
-
-	if (Value.Value == nullptr || !NumericTypes.Contains(Value.Key.ValueType))
+	if (SourceType.ContainerType != EPropertyBagContainerType::None || DestType.ContainerType != EPropertyBagContainerType::None)
 	{
-		return false;
+		return nullptr;
 	}
 
-	TOptional<double> SourceDouble;
-	TOptional<int64> SourceInt;
-	TOptional<uint64> SourceUInt;
-	if (Value.Key.ValueType == EPropertyBagPropertyType::Double)
-	{
-		const double* Number = reinterpret_cast<const double*>(Value.Value);
-		SourceDouble = *Number;
-	}
-	else if (Value.Key.ValueType == EPropertyBagPropertyType::Float)
-	{
-		const float* Number = reinterpret_cast<const float*>(Value.Value);
-		SourceDouble = *Number;
-	}
-	else if (Value.Key.ValueType == EPropertyBagPropertyType::Int32)
-	{
-		const int32* Number = reinterpret_cast<const int32*>(Value.Value);
-		SourceInt = *Number;
-	}
-	else if (Value.Key.ValueType == EPropertyBagPropertyType::Int64)
-	{
-		const int64* Number = reinterpret_cast<const int64*>(Value.Value);
-		SourceInt = *Number;
-	}
-	else if (Value.Key.ValueType == EPropertyBagPropertyType::UInt32)
+	switch (SourceType.ValueType)
 	{
-		const uint32* Number = reinterpret_cast<const uint32*>(Value.Value);
-		SourceUInt = *Number;
-	}
-	else if (Value.Key.ValueType == EPropertyBagPropertyType::UInt64)
-	{
-		const uint64* Number = reinterpret_cast<const uint64*>(Value.Value);
-		SourceUInt = *Number;
+	case EPropertyBagPropertyType::Double:
+		return MDSSTHN::GetKernel<double>(DestType.ValueType);
+	case EPropertyBagPropertyType::Float:
+		return MDSSTHN::GetKernel<float>(DestType.ValueType);
+	case EPropertyBagPropertyType::Int32:
+		return MDSSTHN::GetKernel<int32>(DestType.ValueType);
+	case EPropertyBagPropertyType::Int64:
+		return MDSSTHN::GetKernel<int64>(DestType.ValueType);
+	case EPropertyBagPropertyType::UInt32:
+		return MDSSTHN::GetKernel<uint32>(DestType.ValueType);
+	case EPropertyBagPropertyType::UInt64:
+		return MDSSTHN::GetKernel<uint64>(DestType.ValueType);
+	default:
+		return nullptr;
 	}
+}
 
-	auto CopyNumber = [&DestDesc, DestPtr](auto SourceValue)
+bool UMDStyleSetTypeHandler_Numeric::TrySetStyleValue(const FMDStyleValueView& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const
+{
+	if (!Value.IsValid())
 	{
-		if (DestDesc.ValueType == EPropertyBagPropertyType::Double)
-		{
-			double* Number = static_cast<double*>(DestPtr);
-			*Number = SourceValue;
-			return true;
-		}
-		else if (DestDesc.ValueType == EPropertyBagPropertyType::Float)
-		{
-			float* Number = static_cast<float*>(DestPtr);
-			*Number = SourceValue;
-			return true;
-		}
-		else if (DestDesc.ValueType == EPropertyBagPropertyType::Int32)
-		{
-			int32* Number = static_cast<int32*>(DestPtr);
-			*Number = SourceValue;
-			return true;
-		}
-		else if (DestDesc.ValueType == EPropertyBagPropertyType::Int64)
-		{
-			int64* Number = static_cast<int64*>(DestPtr);
-			*Number = SourceValue;
-			return true;
-		}
-		else if (DestDesc.ValueType == EPropertyBagPropertyType::UInt32)
-		{
-			uint32* Number = static_cast<uint32*>(DestPtr);
-			*Number = SourceValue;
-			return true;
-		}
-		else if (DestDesc.ValueType == EPropertyBagPropertyType::UInt64)
-		{
-			uint64* Number = static_cast<uint64*>(DestPtr);
-			*Number = SourceValue;
-			return true;
-		}
-
 		return false;
-	};
-
-	if (SourceDouble.IsSet())
-	{
-		return CopyNumber(SourceDouble.GetValue());
-	}
-	else if (SourceInt.IsSet())
-	{
-		return CopyNumber(SourceInt.GetValue());
-	}
-	else if (SourceUInt.IsSet())
-	{
-		return CopyNumber(SourceUInt.GetValue());
 	}
 
-	return false;
+	const FMDStyleSetConversionKernel Kernel = GetConversionKernel(FMDStyleSetTypeKey::FromDesc(*Value.GetPropertyDesc()), FMDStyleSetTypeKey::FromDesc(DestDesc));
+	return Kernel != nullptr && Kernel(DestDesc.CachedProperty, Value.GetMemory(), DestPtr);
+}
+
+bool UMDStyleSetTypeHandler_Numeric::TrySetValue(const TTuple<FPropertyBagPropertyDesc, const uint8*>& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const
+{
+	return TrySetStyleValue(FMDStyleValueView(&Value.Key, Value.Value), DestDesc, DestPtr);
 }
 
 FText UMDStyleSetTypeHandler_Numeric::CreateValuePreviewText_Implementation(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag) const
@@ -0,0 +1,118 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Util/MDStyleSetBindingPathResolver.h"
+
+FMDStyleSetBindingPathResolver::FMDStyleSetBindingPathResolver(FPropertyBindingDataView BaseView)
+{
+	Nodes.Add({ BaseView, {} });
+}
+
+FMDStyleSetBindingTarget FMDStyleSetBindingPathResolver::Resolve(const FPropertyBindingPath& Path, FString* OutError)
+{
+	const int32 NumSegments = Path.NumSegments();
+	if (NumSegments == 0)
+	{
+		return {};
+	}
+
+	int32 NodeIndex = 0;
+	for (int32 i = 0; i < NumSegments - 1 && NodeIndex != INDEX_NONE; ++i)
+	{
+		NodeIndex = FindOrAddChild(NodeIndex, Path.GetSegment(i));
+	}
+
+	// Parents that can't be shared (e.g. instanced structs) resolve the whole path
+	if (NodeIndex == INDEX_NONE)
+	{
+		return ResolveFromView(Nodes[0].View, Path, OutError);
+	}
+
+	const FPropertyBindingPathSegment& LeafSegment = Path.GetSegment(NumSegments - 1);
+	RemoveChildren(NodeIndex, LeafSegment);
+
+	FPropertyBindingPath LeafPath;
+	LeafPath.AddPathSegment(LeafSegment);
+	return ResolveFromView(Nodes[NodeIndex].View, LeafPath, OutError);
+}
+
+FMDStyleSetBindingTarget FMDStyleSetBindingPathResolver::ResolveFromView(const FPropertyBindingDataView& View, const FPropertyBindingPath& Path, FString* OutError)
+{
+	FMDStyleSetBindingTarget Target;
+
+	TArray<FPropertyBindingPathIndirection> Indirections;
+	if (Path.ResolveIndirectionsWithValue(View, Indirections, OutError, true) && !Indirections.IsEmpty())
+	{
+		const FPropertyBindingPathIndirection& Indirection = Indirections.Last();
+		if (Indirection.GetContainerAddress() != nullptr)
+		{
+			Target.Property = Indirection.GetProperty();
+			Target.Address = Indirection.GetMutablePropertyAddress();
+		}
+	}
+
+	return Target;
+}
+
+int32 FMDStyleSetBindingPathResolver::FindOrAddChild(int32 ParentIndex, const FPropertyBindingPathSegment& Segment)
+{
+	const TPair<FName, int32> Key(Segment.GetName(), Segment.GetArrayIndex());
+	if (const int32* ExistingIndex = Nodes[ParentIndex].Children.Find(Key))
+	{
+		return *ExistingIndex;
+	}
+
+	int32 ChildIndex = INDEX_NONE;
+
+	FPropertyBindingPath SegmentPath;
+	SegmentPath.AddPathSegment(Segment);
+
+	TArray<FPropertyBindingPathIndirection> Indirections;
+	if (Segment.GetInstanceStruct() == nullptr
+		&& SegmentPath.ResolveIndirectionsWithValue(Nodes[ParentIndex].View, Indirections, nullptr, true)
+		&& !Indirections.IsEmpty()
+		&& Indirections.Last().GetContainerAddress() != nullptr)
+	{
+		const FPropertyBindingPathIndirection& Indirection = Indirections.Last();
+		void* ValueAddress = Indirection.GetMutablePropertyAddress();
+
+		const FProperty* ValueProperty = Indirection.GetProperty();
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(ValueProperty); ArrayProperty != nullptr && Segment.GetArrayIndex() != INDEX_NONE)
+		{
+			ValueProperty = ArrayProperty->Inner;
+		}
+
+		FPropertyBindingDataView ChildView;
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(ValueProperty))
+		{
+			ChildView = FPropertyBindingDataView(StructProperty->Struct, ValueAddress);
+		}
+		else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(ValueProperty))
+		{
+			if (UObject* Object = ObjectProperty->GetObjectPropertyValue(ValueAddress))
+			{
+				ChildView = FPropertyBindingDataView(Object);
+			}
+		}
+
+		if (ChildView.IsValid())
+		{
+			ChildIndex = Nodes.Add({ ChildView, {} });
+		}
+	}
+
+	Nodes[ParentIndex].Children.Add(Key, ChildIndex);
+	return ChildIndex;
+}
+
+void FMDStyleSetBindingPathResolver::RemoveChildren(int32 ParentIndex, const FPropertyBindingPathSegment& Segment)
+{
+	// The removed nodes stay allocated but can't be reached anymore
+	for (auto It = Nodes[ParentIndex].Children.CreateIterator(); It; ++It)
+	{
+		if (It->Key.Key == Segment.GetName())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,162 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Util/MDStyleSetConversionTable.h"
+
+namespace MDSSCT
+{
+	FMDStyleSetTypeKey GetValueTypeKey(const FProperty* Property)
+	{
+		FMDStyleSetTypeKey Key;
+
+		if (CastField<FBoolProperty>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::Bool;
+		}
+		else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+		{
+			Key.ValueType = ByteProperty->Enum != nullptr ? EPropertyBagPropertyType::Enum : EPropertyBagPropertyType::Byte;
+			Key.ValueTypeObject = ByteProperty->Enum;
+		}
+		else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			Key.ValueType = EPropertyBagPropertyType::Enum;
+			Key.ValueTypeObject = EnumProperty->GetEnum();
+		}
+		else if (CastField<FIntProperty>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::Int32;
+		}
+		else if (CastField<FInt64Property>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::Int64;
+		}
+		else if (CastField<FUInt32Property>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::UInt32;
+		}
+		else if (CastField<FUInt64Property>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::UInt64;
+		}
+		else if (CastField<FFloatProperty>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::Float;
+		}
+		else if (CastField<FDoubleProperty>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::Double;
+		}
+		else if (CastField<FNameProperty>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::Name;
+		}
+		else if (CastField<FStrProperty>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::String;
+		}
+		else if (CastField<FTextProperty>(Property) != nullptr)
+		{
+			Key.ValueType = EPropertyBagPropertyType::Text;
+		}
+		else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			Key.ValueType = EPropertyBagPropertyType::Struct;
+			Key.ValueTypeObject = StructProperty->Struct;
+		}
+		else if (const FClassProperty* ClassProperty = CastField<FClassProperty>(Property))
+		{
+			Key.ValueType = EPropertyBagPropertyType::Class;
+			Key.ValueTypeObject = ClassProperty->MetaClass;
+		}
+		else if (const FSoftClassProperty* SoftClassProperty = CastField<FSoftClassProperty>(Property))
+		{
+			Key.ValueType = EPropertyBagPropertyType::SoftClass;
+			Key.ValueTypeObject = SoftClassProperty->MetaClass;
+		}
+		else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+		{
+			Key.ValueType = EPropertyBagPropertyType::Object;
+			Key.ValueTypeObject = ObjectProperty->PropertyClass;
+		}
+		else if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property))
+		{
+			Key.ValueType = EPropertyBagPropertyType::SoftObject;
+			Key.ValueTypeObject = SoftObjectProperty->PropertyClass;
+		}
+
+		return Key;
+	}
+}
+
+FMDStyleSetTypeKey FMDStyleSetTypeKey::FromProperty(const FProperty* Property)
+{
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FMDStyleSetTypeKey Key = MDSSCT::GetValueTypeKey(ArrayProperty->Inner);
+		Key.ContainerType = EPropertyBagContainerType::Array;
+		return Key;
+	}
+
+	if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		FMDStyleSetTypeKey Key = MDSSCT::GetValueTypeKey(SetProperty->ElementProp);
+		Key.ContainerType = EPropertyBagContainerType::Set;
+		return Key;
+	}
+
+	return MDSSCT::GetValueTypeKey(Property);
+}
+
+FMDStyleSetTypeKey FMDStyleSetTypeKey::FromDesc(const FPropertyBagPropertyDesc& Desc)
+{
+	// Nested containers can't be described by a key
+	if (Desc.ContainerTypes.Num() > 1)
+	{
+		return {};
+	}
+
+	FMDStyleSetTypeKey Key;
+	Key.ValueType = Desc.ValueType;
+	Key.ContainerType = Desc.ContainerTypes.GetFirstContainerType();
+	Key.ValueTypeObject = Desc.ValueTypeObject.Get();
+	return Key;
+}
+
+void FMDStyleSetConversionTable::Reset()
+{
+	SourceDesc = nullptr;
+	Kernels.Reset();
+}
+
+void FMDStyleSetConversionTable::SetSourceDesc(const FPropertyBagPropertyDesc* Desc)
+{
+	SourceDesc = Desc;
+}
+
+void FMDStyleSetConversionTable::AddKernel(const FMDStyleSetTypeKey& DestKey, FMDStyleSetConversionKernel Kernel)
+{
+	if (Kernel != nullptr && DestKey.IsValid() && FindKernel(DestKey) == nullptr)
+	{
+		Kernels.Emplace(DestKey, Kernel);
+	}
+}
+
+FMDStyleSetConversionKernel FMDStyleSetConversionTable::FindKernel(const FMDStyleSetTypeKey& DestKey) const
+{
+	for (const TPair<FMDStyleSetTypeKey, FMDStyleSetConversionKernel>& Pair : Kernels)
+	{
+		if (Pair.Key == DestKey)
+		{
+			return Pair.Value;
+		}
+	}
+
+	return nullptr;
+}
+
+bool FMDStyleSetConversionTable::CopyValue(const FProperty* DestProp, const uint8* Source, void* Dest)
+{
+	DestProp->CopyCompleteValue(Dest, Source);
+	return true;
+}
@@ -0,0 +1,181 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Util/MDStyleSetConvertibleType.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "MDStyleSet.h"
+
+namespace MDSSCVT
+{
+	// Bump when the encoding changes, older tags fall back to the legacy parsing
+	const FStringView TagVersionPrefix = TEXTVIEW("MDSSCT1|");
+
+	constexpr TCHAR EntryDelimiter = TEXT(';');
+	constexpr TCHAR FieldDelimiter = TEXT(',');
+
+	const UClass* ResolveClass(const FSoftObjectPath& ClassPath)
+	{
+		if (ClassPath.IsNull())
+		{
+			return nullptr;
+		}
+
+		if (const UClass* Class = Cast<UClass>(ClassPath.ResolveObject()))
+		{
+			return Class;
+		}
+
+		return Cast<UClass>(ClassPath.TryLoad());
+	}
+
+	// Tags saved before the compact encoding are newline separated FPropertyBagPropertyDesc text exports
+	TArray<FMDStyleSetConvertibleType> DecodeLegacyTagValue(const FString& TagValue)
+	{
+		TArray<FMDStyleSetConvertibleType> Result;
+
+		TArray<FString> ConvertibleTypeStrings;
+		TagValue.ParseIntoArrayLines(ConvertibleTypeStrings);
+
+		for (const FString& ConvertibleTypeString : ConvertibleTypeStrings)
+		{
+			FPropertyBagPropertyDesc ConvertibleTypeDesc;
+			FPropertyBagPropertyDesc::StaticStruct()->ImportText(*ConvertibleTypeString, &ConvertibleTypeDesc, nullptr, PPF_None, nullptr, FPropertyBagPropertyDesc::StaticStruct()->GetName());
+			Result.Add(FMDStyleSetConvertibleType::FromDesc(ConvertibleTypeDesc));
+		}
+
+		return Result;
+	}
+}
+
+FMDStyleSetConvertibleType FMDStyleSetConvertibleType::FromDesc(const FPropertyBagPropertyDesc& Desc)
+{
+	FMDStyleSetConvertibleType Type;
+	Type.ValueType = Desc.ValueType;
+	Type.ContainerType = Desc.ContainerTypes.GetFirstContainerType();
+	Type.ValueTypeObjectPath = FSoftObjectPath(Desc.ValueTypeObject);
+	Type.UpdateTypeHash();
+	return Type;
+}
+
+TArray<FMDStyleSetConvertibleType> FMDStyleSetConvertibleType::FromAssetData(const FAssetData& Asset)
+{
+	TArray<FMDStyleSetConvertibleType> Result;
+
+	FString TagValue;
+	if (Asset.GetTagValue(UMDStyleSet::ConvertibleTypesAssetTagName, TagValue) && !DecodeTagValue(TagValue, Result))
+	{
+		Result = MDSSCVT::DecodeLegacyTagValue(TagValue);
+	}
+
+	return Result;
+}
+
+FString FMDStyleSetConvertibleType::EncodeTagValue(TConstArrayView<FPropertyBagPropertyDesc> Types)
+{
+	TStringBuilder<256> Builder;
+	Builder << MDSSCVT::TagVersionPrefix;
+
+	for (int32 i = 0; i < Types.Num(); ++i)
+	{
+		const FMDStyleSetConvertibleType Type = FromDesc(Types[i]);
+		if (i > 0)
+		{
+			Builder << MDSSCVT::EntryDelimiter;
+		}
+
+		Builder.Appendf(TEXT("%08x%c%u%c%u%c"), Type.TypeHash, MDSSCVT::FieldDelimiter, static_cast<uint32>(Type.ValueType), MDSSCVT::FieldDelimiter, static_cast<uint32>(Type.ContainerType), MDSSCVT::FieldDelimiter);
+		Type.ValueTypeObjectPath.AppendString(Builder);
+	}
+
+	return Builder.ToString();
+}
+
+bool FMDStyleSetConvertibleType::DecodeTagValue(FStringView TagValue, TArray<FMDStyleSetConvertibleType>& OutTypes)
+{
+	if (!TagValue.StartsWith(MDSSCVT::TagVersionPrefix))
+	{
+		return false;
+	}
+
+	TagValue.RightChopInline(MDSSCVT::TagVersionPrefix.Len());
+
+	while (!TagValue.IsEmpty())
+	{
+		int32 EntryEnd = INDEX_NONE;
+		if (!TagValue.FindChar(MDSSCVT::EntryDelimiter, EntryEnd))
+		{
+			EntryEnd = TagValue.Len();
+		}
+
+		FStringView Entry = TagValue.Left(EntryEnd);
+		TagValue.RightChopInline(EntryEnd + 1);
+
+		// Hash, value type and container type are fixed fields, the type object path is the remainder of the entry
+		FStringView Fields[3];
+		for (FStringView& Field : Fields)
+		{
+			int32 FieldEnd = INDEX_NONE;
+			if (!Entry.FindChar(MDSSCVT::FieldDelimiter, FieldEnd))
+			{
+				return false;
+			}
+
+			Field = Entry.Left(FieldEnd);
+			Entry.RightChopInline(FieldEnd + 1);
+		}
+
+		FMDStyleSetConvertibleType& Type = OutTypes.AddDefaulted_GetRef();
+		Type.TypeHash = static_cast<uint32>(FCString::Strtoui64(*FString(Fields[0]), nullptr, 16));
+		Type.ValueType = static_cast<EPropertyBagPropertyType>(FCString::Atoi(*FString(Fields[1])));
+		Type.ContainerType = static_cast<EPropertyBagContainerType>(FCString::Atoi(*FString(Fields[2])));
+		Type.ValueTypeObjectPath = FSoftObjectPath(Entry);
+	}
+
+	return true;
+}
+
+FPropertyBagPropertyDesc FMDStyleSetConvertibleType::ToDesc() const
+{
+	const UObject* ValueTypeObject = ValueTypeObjectPath.IsNull() ? nullptr : ValueTypeObjectPath.TryLoad();
+
+	return FPropertyBagPropertyDesc(NAME_None, ContainerType, ValueType, ValueTypeObject);
+}
+
+bool FMDStyleSetConvertibleType::IsCompatibleWith(const FMDStyleSetConvertibleType& Other) const
+{
+	if (ValueType != Other.ValueType || ContainerType != Other.ContainerType)
+	{
+		return false;
+	}
+
+	if (MatchesTypeObjectExactly())
+	{
+		// The hash only rejects quickly, the paths are still compared in case of a collision
+		return TypeHash == Other.TypeHash && ValueTypeObjectPath == Other.ValueTypeObjectPath;
+	}
+
+	if (ValueType == EPropertyBagPropertyType::Object)
+	{
+		// Objects are compatible with their parent classes
+		const UClass* ObjectClass = MDSSCVT::ResolveClass(ValueTypeObjectPath);
+		const UClass* OtherObjectClass = MDSSCVT::ResolveClass(Other.ValueTypeObjectPath);
+		return ObjectClass != nullptr && OtherObjectClass != nullptr && ObjectClass->IsChildOf(OtherObjectClass);
+	}
+
+	return true;
+}
+
+bool FMDStyleSetConvertibleType::MatchesTypeObjectExactly() const
+{
+	return ValueType == EPropertyBagPropertyType::Enum || ValueType == EPropertyBagPropertyType::Struct;
+}
+
+void FMDStyleSetConvertibleType::UpdateTypeHash()
+{
+	// Only uses stable values so the hash can be saved in the asset registry
+	TStringBuilder<256> PathString;
+	ValueTypeObjectPath.AppendString(PathString);
+
+	TypeHash = HashCombine(HashCombine(static_cast<uint32>(ValueType), static_cast<uint32>(ContainerType)), FCrc::StrCrc32(PathString.ToString()));
+}
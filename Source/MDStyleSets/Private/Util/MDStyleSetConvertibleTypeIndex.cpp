@@ -0,0 +1,178 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Util/MDStyleSetConvertibleTypeIndex.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "MDStyleSet.h"
+
+namespace MDSSCTI
+{
+	TUniquePtr<FMDStyleSetConvertibleTypeIndex> Instance;
+}
+
+FMDStyleSetConvertibleTypeIndex& FMDStyleSetConvertibleTypeIndex::Get()
+{
+	if (!MDSSCTI::Instance.IsValid())
+	{
+		MDSSCTI::Instance = TUniquePtr<FMDStyleSetConvertibleTypeIndex>(new FMDStyleSetConvertibleTypeIndex());
+	}
+
+	return *MDSSCTI::Instance;
+}
+
+void FMDStyleSetConvertibleTypeIndex::TearDown()
+{
+	MDSSCTI::Instance.Reset();
+}
+
+FMDStyleSetConvertibleTypeIndex::FMDStyleSetConvertibleTypeIndex()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMDStyleSetConvertibleTypeIndex::OnAssetAdded);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FMDStyleSetConvertibleTypeIndex::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMDStyleSetConvertibleTypeIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMDStyleSetConvertibleTypeIndex::OnAssetRenamed);
+	FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FMDStyleSetConvertibleTypeIndex::RebuildIndex);
+
+	RebuildIndex();
+}
+
+FMDStyleSetConvertibleTypeIndex::~FMDStyleSetConvertibleTypeIndex()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+	}
+}
+
+bool FMDStyleSetConvertibleTypeIndex::HasConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc) const
+{
+	const FMDStyleSetConvertibleType Type = FMDStyleSetConvertibleType::FromDesc(Desc);
+	if (const TArray<FIndexedType>* Bucket = TypeBuckets.Find(GetBucketKey(Type)))
+	{
+		for (const FIndexedType& IndexedType : *Bucket)
+		{
+			if (IndexedType.Type.IsCompatibleWith(Type))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+TArray<FAssetData> FMDStyleSetConvertibleTypeIndex::GetConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc) const
+{
+	TArray<FAssetData> Result;
+
+	const FMDStyleSetConvertibleType Type = FMDStyleSetConvertibleType::FromDesc(Desc);
+	if (const TArray<FIndexedType>* Bucket = TypeBuckets.Find(GetBucketKey(Type)))
+	{
+		TSet<FSoftObjectPath> AddedStyleSets;
+		for (const FIndexedType& IndexedType : *Bucket)
+		{
+			if (IndexedType.Type.IsCompatibleWith(Type) && !AddedStyleSets.Contains(IndexedType.StyleSetPath))
+			{
+				if (const FAssetData* AssetData = StyleSets.Find(IndexedType.StyleSetPath))
+				{
+					AddedStyleSets.Add(IndexedType.StyleSetPath);
+					Result.Add(*AssetData);
+				}
+			}
+		}
+	}
+
+	return Result;
+}
+
+void FMDStyleSetConvertibleTypeIndex::RebuildIndex()
+{
+	StyleSets.Reset();
+	TypeBuckets.Reset();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> Assets;
+	if (AssetRegistry.GetAssetsByClass(UMDStyleSet::StaticClass()->GetClassPathName(), Assets, true))
+	{
+		for (const FAssetData& Asset : Assets)
+		{
+			AddStyleSet(Asset);
+		}
+	}
+}
+
+void FMDStyleSetConvertibleTypeIndex::AddStyleSet(const FAssetData& AssetData)
+{
+	const FSoftObjectPath StyleSetPath = AssetData.GetSoftObjectPath();
+
+	// Updated assets are re-added, clear out their previous types first
+	RemoveStyleSet(StyleSetPath);
+
+	StyleSets.Add(StyleSetPath, AssetData);
+
+	for (FMDStyleSetConvertibleType& Type : FMDStyleSetConvertibleType::FromAssetData(AssetData))
+	{
+		TypeBuckets.FindOrAdd(GetBucketKey(Type)).Add({ MoveTemp(Type), StyleSetPath });
+	}
+}
+
+void FMDStyleSetConvertibleTypeIndex::RemoveStyleSet(const FSoftObjectPath& StyleSetPath)
+{
+	if (StyleSets.Remove(StyleSetPath) == 0)
+	{
+		return;
+	}
+
+	for (auto It = TypeBuckets.CreateIterator(); It; ++It)
+	{
+		It->Value.RemoveAllSwap([&StyleSetPath](const FIndexedType& IndexedType)
+		{
+			return IndexedType.StyleSetPath == StyleSetPath;
+		});
+
+		if (It->Value.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FMDStyleSetConvertibleTypeIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	if (AssetData.IsInstanceOf(UMDStyleSet::StaticClass()))
+	{
+		AddStyleSet(AssetData);
+	}
+}
+
+void FMDStyleSetConvertibleTypeIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	RemoveStyleSet(AssetData.GetSoftObjectPath());
+}
+
+void FMDStyleSetConvertibleTypeIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	RemoveStyleSet(FSoftObjectPath(OldObjectPath));
+	OnAssetAdded(AssetData);
+}
+
+uint32 FMDStyleSetConvertibleTypeIndex::GetBucketKey(const FMDStyleSetConvertibleType& Type)
+{
+	// Struct and enum types need the same type object so they're bucketed by their type hash, other types only need the same value and container type
+	if (Type.MatchesTypeObjectExactly())
+	{
+		return Type.TypeHash;
+	}
+
+	return HashCombineFast(GetTypeHash(Type.ValueType), GetTypeHash(Type.ContainerType));
+}
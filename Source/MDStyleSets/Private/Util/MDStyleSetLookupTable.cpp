@@ -0,0 +1,146 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Util/MDStyleSetLookupTable.h"
+
+#include "Algo/BinarySearch.h"
+#include "PropertyBag.h"
+
+namespace MDSSLT
+{
+	bool TagLess(const FGameplayTag& A, const FGameplayTag& B)
+	{
+		return A.GetTagName().FastLess(B.GetTagName());
+	}
+}
+
+bool FMDStyleSetLookupTable::IsSameValueType(const FPropertyBagPropertyDesc& A, const FPropertyBagPropertyDesc& B)
+{
+	return A.ValueType == B.ValueType && A.ContainerTypes == B.ContainerTypes && A.ValueTypeObject == B.ValueTypeObject;
+}
+
+void FMDStyleSetLookupTable::Reset()
+{
+	Tags.Reset();
+	Descs.Reset();
+	Values.Reset();
+	SharedDesc = nullptr;
+	FallbackDesc = nullptr;
+	FallbackValue = nullptr;
+	bIsBuilt = false;
+}
+
+void FMDStyleSetLookupTable::AddEntry(const FGameplayTag& Tag, const FPropertyBagPropertyDesc* Desc, const uint8* Value)
+{
+	// Entries without a value are still added so they're found, matching the behaviour of the entry map
+	Tags.Add(Tag);
+	Descs.Add((Desc != nullptr && Value != nullptr) ? GetOrAddSharedDesc(Desc) : nullptr);
+	Values.Add((Desc != nullptr) ? Value : nullptr);
+}
+
+void FMDStyleSetLookupTable::SetFallback(const FPropertyBagPropertyDesc* Desc, const uint8* Value)
+{
+	if (Desc != nullptr && Value != nullptr)
+	{
+		FallbackDesc = GetOrAddSharedDesc(Desc);
+		FallbackValue = Value;
+	}
+}
+
+void FMDStyleSetLookupTable::Finalize()
+{
+	TArray<int32> Order;
+	Order.Reserve(Tags.Num());
+	for (int32 i = 0; i < Tags.Num(); ++i)
+	{
+		Order.Add(i);
+	}
+
+	Order.StableSort([this](int32 A, int32 B)
+	{
+		return MDSSLT::TagLess(Tags[A], Tags[B]);
+	});
+
+	TArray<FGameplayTag> SortedTags;
+	TArray<const FPropertyBagPropertyDesc*> SortedDescs;
+	TArray<const uint8*> SortedValues;
+	SortedTags.Reserve(Order.Num());
+	SortedDescs.Reserve(Order.Num());
+	SortedValues.Reserve(Order.Num());
+	for (int32 i : Order)
+	{
+		SortedTags.Add(Tags[i]);
+		SortedDescs.Add(Descs[i]);
+		SortedValues.Add(Values[i]);
+	}
+
+	Tags = MoveTemp(SortedTags);
+	Descs = MoveTemp(SortedDescs);
+	Values = MoveTemp(SortedValues);
+
+	bIsBuilt = true;
+}
+
+void FMDStyleSetLookupTable::Merge(const FMDStyleSetLookupTable& Overrides, const FMDStyleSetLookupTable& Base)
+{
+	Reset();
+
+	SetFallback(Overrides.FallbackDesc, Overrides.FallbackValue);
+	if (FallbackDesc == nullptr)
+	{
+		SetFallback(Base.FallbackDesc, Base.FallbackValue);
+	}
+
+	const int32 NumOverrides = Overrides.IsBuilt() ? Overrides.Num() : 0;
+	const int32 NumBase = Base.IsBuilt() ? Base.Num() : 0;
+	Tags.Reserve(NumOverrides + NumBase);
+	Descs.Reserve(NumOverrides + NumBase);
+	Values.Reserve(NumOverrides + NumBase);
+
+	int32 BaseIndex = 0;
+	for (int32 i = 0; i < NumOverrides; ++i)
+	{
+		const FGameplayTag& Tag = Overrides.Tags[i];
+		for (; BaseIndex < NumBase && MDSSLT::TagLess(Base.Tags[BaseIndex], Tag); ++BaseIndex)
+		{
+			AddEntry(Base.Tags[BaseIndex], Base.Descs[BaseIndex], Base.Values[BaseIndex]);
+		}
+
+		if (BaseIndex < NumBase && Base.Tags[BaseIndex] == Tag)
+		{
+			++BaseIndex;
+		}
+
+		AddEntry(Tag, Overrides.Descs[i], Overrides.Values[i]);
+	}
+
+	for (; BaseIndex < NumBase; ++BaseIndex)
+	{
+		AddEntry(Base.Tags[BaseIndex], Base.Descs[BaseIndex], Base.Values[BaseIndex]);
+	}
+
+	bIsBuilt = true;
+}
+
+int32 FMDStyleSetLookupTable::FindEntryIndex(const FGameplayTag& Tag) const
+{
+	const int32 Index = Algo::LowerBound(Tags, Tag, &MDSSLT::TagLess);
+	if (Tags.IsValidIndex(Index) && Tags[Index] == Tag)
+	{
+		return Index;
+	}
+
+	return INDEX_NONE;
+}
+
+const FPropertyBagPropertyDesc* FMDStyleSetLookupTable::GetOrAddSharedDesc(const FPropertyBagPropertyDesc* Desc)
+{
+	if (SharedDesc == nullptr)
+	{
+		SharedDesc = Desc;
+		return SharedDesc;
+	}
+
+	// Every entry of a set should be the same type, only keep a separate desc for entries that somehow got out of sync
+	return IsSameValueType(*SharedDesc, *Desc) ? SharedDesc : Desc;
+}
@@ -0,0 +1,55 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "Extensions/WidgetBlueprintGeneratedClassExtension.h"
+#include "Util/MDStyleSetTypes.h"
+
+#include "MDStyleSetWidgetClassExtension.generated.h"
+
+class UWidget;
+
+/**
+ * Stores a widget blueprint's Style Set Property Bindings in its generated class so they can be re-applied to live widgets when the theme changes
+ */
+UCLASS()
+class MDSTYLESETS_API UMDStyleSetWidgetClassExtension : public UWidgetBlueprintGeneratedClassExtension
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(UUserWidget* UserWidget) override;
+
+	// Finds the property the binding at BindingIndex writes to on UserWidget, OutWidget is set to the widget that owns the property
+	FMDStyleSetBindingTarget ResolveBindingTarget(UUserWidget* UserWidget, int32 BindingIndex, UWidget*& OutWidget) const;
+
+	const TArray<FMDStyleSetPropertyBinding>& GetBindings() const { return Bindings; }
+
+#if WITH_EDITOR
+	void SetBindings(TArray<FMDStyleSetPropertyBinding>&& InBindings) { Bindings = MoveTemp(InBindings); BoundProperties.Reset(); }
+#endif
+
+private:
+	// A bound property at a fixed offset from the widget that owns it
+	struct FBoundProperty
+	{
+		// NAME_None for properties of the user widget itself
+		FName WidgetName;
+		// Native class declaring the first property of the path, the widget has to be one for the offset to hold
+		const UClass* OwnerClass = nullptr;
+		const FProperty* Property = nullptr;
+		// INDEX_NONE if the path can't be reduced to an offset, e.g. it goes through an array or an object, the path is resolved instead
+		int32 Offset = INDEX_NONE;
+	};
+
+	// Reduces each binding's path to an offset from its widget, from the widgets of the first instance
+	void BuildBoundProperties(UUserWidget* UserWidget);
+
+	static FMDStyleSetBindingTarget ResolveBindingPath(UUserWidget* UserWidget, const FMDStyleSetPropertyBinding& Binding, UWidget*& OutWidget);
+
+	UPROPERTY()
+	TArray<FMDStyleSetPropertyBinding> Bindings;
+
+	// Parallel to Bindings, built when the first widget is initialized
+	TArray<FBoundProperty> BoundProperties;
+};
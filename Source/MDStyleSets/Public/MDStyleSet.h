@@ -5,11 +5,17 @@
 #include "EdGraph/EdGraphPin.h"
 #include "Engine/DataAsset.h"
 #include "GameplayTagContainer.h"
+#include "Hash/Blake3.h"
 #include "PropertyBag.h"
+#include "Util/MDStyleSetConversionTable.h"
+#include "Util/MDStyleSetLookupTable.h"
+#include "Util/MDStyleSetTypes.h"
+#include "Util/MDStyleValueView.h"
 
 #include "MDStyleSet.generated.h"
 
 class UMDStyleSetTypeHandlerBase;
+struct FAssetData;
 
 USTRUCT()
 struct MDSTYLESETS_API FMDStyleValue
@@ -22,7 +28,13 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Style Set", meta = (ShowOnlyInnerProperties, FixedLayout))
 	FInstancedPropertyBag Value;
 
+	FMDStyleValueView GetValueView() const;
+
+	// Prefer GetValueView, which doesn't copy the property desc
 	TTuple<FPropertyBagPropertyDesc, const uint8*> GetValue() const;
+
+	const FPropertyBagPropertyDesc* GetValueDesc() const;
+	const uint8* GetValuePtr(const FPropertyBagPropertyDesc* Desc) const;
 };
 
 UCLASS(BlueprintType)
@@ -32,25 +44,86 @@ class MDSTYLESETS_API UMDStyleSet : public UDataAsset
 
 public:
 	static const FName ConvertibleTypesAssetTagName;
+	static const FName DisplayNameAssetTagName;
+	static const FName StyleTypeAssetTagName;
+	static const FName StyleSetTagAssetTagName;
+	static const FName EntryCountAssetTagName;
+
+	// Read the asset registry tags of a Style Set so menus can be built without loading it
+	static FText GetDisplayNameFromAssetData(const FAssetData& Asset);
+	static FGameplayTag GetStyleSetTagFromAssetData(const FAssetData& Asset);
+	static int32 GetEntryCountFromAssetData(const FAssetData& Asset);
+	// The pin sub category object is only set if it's already loaded
+	static bool GetStyleTypeFromAssetData(const FAssetData& Asset, FEdGraphPinType& OutStyleType);
 
 #if WITH_EDITOR
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnStyleSetEdited, UMDStyleSet* /*StyleSet*/);
+
+	// Broadcast once an edited Style Set's lookup table has been rebuilt
+	static FOnStyleSetEdited OnStyleSetEdited;
+
+	DECLARE_DELEGATE_RetVal_TwoParams(bool, FGatherReferencedTags, const UMDStyleSet* /*StyleSet*/, TSet<FGameplayTag>& /*OutTags*/);
+
+	// Gathers the tags read from the Style Set when cooking it with bStripUnreferencedEntries, returns false if they can't all be known
+	static FGatherReferencedTags GatherReferencedTagsForCook;
+
 	static EPropertyBagPropertyType GetValueTypeFromPinType(const FEdGraphPinType& PinType);
+	virtual void PreEditChange(FProperty* PropertyAboutToChange) override;
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
 	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+
+	// Returns the tags whose value changed since the first edit after loading or since the last call, used to re-bake the blueprints using them when saving
+	TArray<FGameplayTag> ConsumeChangedTags();
+
+	// Changes whenever the value of ValueTag may have changed, including through the base Style Set, never 0
+	uint32 GetEntryVersion(const FGameplayTag& ValueTag) const;
+
+	// Deterministic hash of everything that affects the values bound from this Style Set: the style type, type handler, fallback and every entry including inherited ones
+	FBlake3Hash GetContentHash() const;
 #endif
 
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
 	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	// Rebuilds the table used to look up style values, must be called after modifying StyleEntries or FallbackValue outside of the editor
+	void RebuildLookupTable();
+
+	FMDStyleValueView GetStyleValueView(const FGameplayTag& ValueTag) const;
 
+	// Prefer GetStyleValueView, which doesn't copy the property desc
 	TTuple<FPropertyBagPropertyDesc, const uint8*> GetStyleValue(const FGameplayTag& ValueTag) const;
 
 	bool TrySetPropertyValue(const FGameplayTag& ValueTag, const FProperty* DestProp, void* DestPtr) const;
 
+	// Same as TrySetPropertyValue, but remembers the value and conversion kernel in Cache so reading the same tag into the same property again skips the lookup
+	bool TrySetPropertyValue(const FGameplayTag& ValueTag, const FProperty* DestProp, void* DestPtr, FMDStyleSetValueCache& Cache) const;
+
+	// Changes every time the lookup table is rebuilt or reset, unique across all Style Sets.
+	// Rebuilding or resetting a base Style Set's table also rebuilds or resets the tables of the Style Sets inheriting from it.
+	uint32 GetLookupTableVersion() const { return LookupTableVersion; }
+
+	// Applies the style value of each binding to its target property in order, values and conversion kernels are only looked up once per Style Set, tag and property. Returns the number of values that were set.
+	// Each target is resolved with ResolveTarget right before it's written, so a binding can go through a container written by an earlier binding (e.g. Items then Items[2].Color).
+	static int32 ApplyBindings(TConstArrayView<FMDStyleSetPropertyBinding> Bindings, TFunctionRef<FMDStyleSetBindingTarget(int32 BindingIndex)> ResolveTarget, TArrayView<EMDStyleSetBindingExecutionResult> OutResults = {});
+
+	// Resolves each binding's property path on Target then applies them
+	static int32 ApplyBindings(TConstArrayView<FMDStyleSetPropertyBinding> Bindings, UObject* Target);
+
 	FText GetDisplayName() const { return DisplayName.IsEmpty() ? FText::FromName(GetFName()) : FText::FromString(DisplayName); }
 
 	FText GetValueDisplayName(const FGameplayTag& ValueTag) const;
 
 	bool DoesHaveValueWithTag(const FGameplayTag& ValueTag) const;
 
+	// Returns true if StyleSet is this Style Set or one of its base Style Sets
+	bool IsOrInheritsFrom(const UMDStyleSet* StyleSet) const;
+
+	// Tags of every entry of this Style Set, including the entries inherited from the base Style Set
+	TArray<FGameplayTag> GetStyleTags() const;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Style Set")
 	FEdGraphPinType StyleType;
 
@@ -63,6 +136,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, Instanced, Category = "Style Set")
 	TObjectPtr<UMDStyleSetTypeHandlerBase> TypeHandler = nullptr;
 
+	// Entries that aren't in this Style Set are taken from the base Style Set, so variants only need to contain the entries they change
+	UPROPERTY(EditDefaultsOnly, Category = "Style Set")
+	TObjectPtr<UMDStyleSet> BaseStyleSet = nullptr;
+
+	// When a tag isn't found, use the entry of its closest parent tag (e.g. Style.Button for Style.Button.Hover) before using the Fallback Value
+	UPROPERTY(EditDefaultsOnly, Category = "Style Set")
+	bool bFallbackToParentTags = false;
+
 	// The value to use if the requested tag is not found
 	UPROPERTY(EditDefaultsOnly, Category = "Style Set")
 	FMDStyleValue FallbackValue;
@@ -70,8 +151,127 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Style Set", meta = (ForceInlineRow))
 	TMap<FGameplayTag, FMDStyleValue> StyleEntries;
 
+	// When cooked, store all entries in a single contiguous array instead of a separate property bag per entry. Reduces allocations and speeds up lookups in large style sets.
+	UPROPERTY(EditDefaultsOnly, AdvancedDisplay, Category = "Style Set")
+	bool bPackEntryStorage = false;
+
+#if WITH_EDITORONLY_DATA
+	// When cooked, leave out the entries whose tag isn't read by any blueprint binding or Get Style Value node. Tags only read from C++ or data must be added to Cook Keep Tags.
+	UPROPERTY(EditDefaultsOnly, AdvancedDisplay, Category = "Style Set")
+	bool bStripUnreferencedEntries = false;
+
+	// Entries matching these tags are always cooked when stripping unreferenced entries
+	UPROPERTY(EditDefaultsOnly, AdvancedDisplay, Category = "Style Set", meta = (Categories = "Style", EditCondition = "bStripUnreferencedEntries"))
+	FGameplayTagContainer CookKeepTags;
+#endif
+
 private:
+	// Resets the lookup table of this Style Set and the flattened table of every Style Set that uses it as a base
+	void ResetLookupTable();
+	void ResetFlattenedLookupTable();
+
+	// Merges the base's entries into the lookup table again, without rebuilding the table of our own entries
+	void RebuildInheritedEntries();
+	void FinishRebuildingLookupTable(const UMDStyleSet* Base);
+	void RebuildDependentLookupTables();
+
+	UMDStyleSet* GetValidBaseStyleSet() const;
+
+#if WITH_EDITOR
+	// Moves the entries matching the style type into PackedEntryTags and PackedEntryValues, returns the entries that couldn't be packed
+	TMap<FGameplayTag, FMDStyleValue> PackEntries();
+
+	// The entries to cook, without the unreferenced entries if bStripUnreferencedEntries is set
+	TMap<FGameplayTag, FMDStyleValue> GetCookedEntries() const;
+
+	// CRC of the exported text of each tag's value
+	TMap<FGameplayTag, uint32> CalculateValueHashes() const;
+
+	// Stamps the edited entry with a new version, or the whole Style Set if the edit isn't limited to a single entry's value or changes the entry tags
+	void UpdateVersions(const FPropertyChangedEvent& PropertyChangedEvent);
+	void BumpSetVersion();
+	int64 MakeVersion();
+#endif
+
+	// Resolves the conversion kernels from the style type to each convertible type of the TypeHandler
+	void RebuildConversionTable();
+
+	// Sets OutValue to the value of ValueTag or to the fallback value, returns false if the fallback value was used
+	bool FindStyleValue(const FGameplayTag& ValueTag, FMDStyleValueView& OutValue) const;
+
+	// Finds ValueTag in the entries or the packed entries of this Style Set or its base Style Sets without the lookup table, for lookups while it isn't built
+	bool FindUnindexedEntry(const FGameplayTag& ValueTag, FMDStyleValueView& OutValue) const;
+	bool FindOwnUnindexedEntry(const FGameplayTag& ValueTag, FMDStyleValueView& OutValue) const;
+
+	// Builds PackedValueDesc from the packed values array
+	void UpdatePackedValueDesc();
+
+	// Finds the entry of the closest parent of ValueTag in the lookup table, the result is memoized until the table is rebuilt
+	int32 FindParentTagEntryIndex(const FGameplayTag& ValueTag) const;
+	void ResetParentTagEntryIndices();
+
+	FMDStyleSetConversionKernel FindConversionKernel(const FProperty* DestProp) const;
+
+	// Sets the value without the cached conversion kernels
+	bool TrySetPropertyValueFromView(const FMDStyleValueView& Value, const FProperty* DestProp, void* DestPtr) const;
+
 	// Sort entries alphabetically by their tag
 	UFUNCTION(CallInEditor, Category = "Style Set")
 	void SortEntries();
+
+	static const FName PackedValuesPropertyName;
+
+	// Tags of the packed entries, parallel to the values array in PackedEntryValues. Only populated in cooked style sets.
+	UPROPERTY()
+	TArray<FGameplayTag> PackedEntryTags;
+
+	// Holds a single array of the style type with the values of the packed entries. Only populated in cooked style sets.
+	UPROPERTY()
+	FInstancedPropertyBag PackedEntryValues;
+
+	// Desc of a single packed value, shared by every packed entry
+	FPropertyBagPropertyDesc PackedValueDesc;
+
+	FMDStyleSetLookupTable LookupTable;
+	FMDStyleSetConversionTable ConversionTable;
+
+	// Lookup table index of the closest parent entry of each tag looked up without an entry, INDEX_NONE if no parent has one
+	mutable TMap<FGameplayTag, int32> ParentTagEntryIndices;
+	mutable FRWLock ParentTagEntryIndicesLock;
+
+	// Only this Style Set's entries, kept when there's a base Style Set so the lookup table can be merged again when the base changes
+	FMDStyleSetLookupTable OwnLookupTable;
+
+	// Style Sets using this one as a base, their lookup tables point to this Style Set's values
+	TArray<TWeakObjectPtr<UMDStyleSet>> DependentStyleSets;
+
+#if WITH_EDITORONLY_DATA
+
+	// Value hashes from before the first edit since the changed tags were last consumed
+	TOptional<TMap<FGameplayTag, uint32>> SavedValueHashes;
+
+	// Entry tags from before the current edit, to tell edits of an entry's value from edits of its key
+	TArray<FGameplayTag> PreEditEntryTags;
+
+	// Versions are UTC ticks of the edit, so they keep increasing across editor sessions even if an edit isn't saved
+	UPROPERTY()
+	int64 LastVersion = 0;
+
+	// Version of the last edit that wasn't limited to a single entry's value, e.g. the style type or base Style Set
+	UPROPERTY()
+	int64 SetVersion = 0;
+
+	UPROPERTY()
+	TMap<FGameplayTag, int64> EntryVersions;
+
+	// Content hash and the lookup table version it was calculated for
+	mutable FBlake3Hash CachedContentHash;
+	mutable uint32 CachedContentHashVersion = 0;
+#endif
+
+	bool bIsRebuildingLookupTable = false;
+
+	uint32 LookupTableVersion = 0;
+
+	void BumpLookupTableVersion();
 };
@@ -4,10 +4,14 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "PropertyBag.h"
+#include "Util/MDStyleValueView.h"
 
 #include "MDStyleSetFunctionLibrary.generated.h"
 
+struct FMDStyleSetSoftValueReference;
+struct FMDStyleSetValueCache;
 struct FMDStyleSetValueReference;
+struct FStreamableHandle;
 struct FGameplayTag;
 class UMDStyleSet;
 
@@ -24,12 +28,29 @@ public:
 	static void GetStyleValue(UMDStyleSet* StyleSet, UPARAM(meta = (Categories = "Style")) const FGameplayTag& StyleTag, int32& OutValue);
 	DECLARE_FUNCTION(execGetStyleValue);
 
+	// Used by Get Style Value nodes with a dynamic tag, Cache is a variable of the blueprint instance for each node
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "OutValue", AutoCreateRefTerm = "StyleTag"))
+	static void GetStyleValueCached(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag, UPARAM(ref) FMDStyleSetValueCache& Cache, int32& OutValue);
+	DECLARE_FUNCTION(execGetStyleValueCached);
+
+	static FMDStyleValueView GetStyleSetValueView(const FMDStyleSetValueReference& ValueReference);
+
+	// Returns an invalid view if the Style Set isn't loaded, never loads it
+	static FMDStyleValueView GetStyleSetValueView(const FMDStyleSetSoftValueReference& ValueReference);
+
+	// Streams in the Style Set then calls OnLoaded with the value, the returned handle keeps the Style Set loaded until it's released
+	static TSharedPtr<FStreamableHandle> GetStyleValueAsync(const FMDStyleSetSoftValueReference& ValueReference, TFunction<void(const FMDStyleValueView&)>&& OnLoaded);
+
+	// Prefer GetStyleSetValueView, which doesn't copy the property desc
 	static TTuple<FPropertyBagPropertyDesc, const uint8*> GetStyleSetValue(const FMDStyleSetValueReference& ValueReference);
 
 	static bool HasConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc);
 
+	// Loads every Style Set that can be converted to Desc, prefer GetConvertibleStyleSetAssets
 	static TArray<UMDStyleSet*> GetConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc);
 
+	static TArray<FAssetData> GetConvertibleStyleSetAssets(const FPropertyBagPropertyDesc& Desc);
+
 	static TArray<FPropertyBagPropertyDesc> GetConvertibleTypes(const FAssetData& Asset);
 
 };
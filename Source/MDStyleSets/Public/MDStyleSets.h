@@ -3,8 +3,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
 #include "Modules/ModuleManager.h"
 
+LLM_DECLARE_TAG_API(MDStyleSets, MDSTYLESETS_API);
+
 class FMDStyleSetsModule : public IModuleInterface
 {
 public:
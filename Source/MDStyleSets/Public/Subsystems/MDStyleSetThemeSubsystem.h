@@ -0,0 +1,89 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "MDStyleSetThemeSubsystem.generated.h"
+
+class UMDStyleSet;
+class UMDStyleSetWidgetClassExtension;
+class UUserWidget;
+
+/**
+ * Switches themes at runtime by overriding Style Sets with other Style Sets, then re-applies the affected bindings of live widgets.
+ * Only bindings whose value actually changed are re-applied, and the work is spread across frames (see MDStyleSets.ThemeApplyBudgetMs).
+ */
+UCLASS()
+class MDSTYLESETS_API UMDStyleSetThemeSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Bound widgets will use the values of OverrideStyleSet in place of the values of StyleSet
+	UFUNCTION(BlueprintCallable, Category = "Style Set")
+	void SetStyleSetOverride(UMDStyleSet* StyleSet, UMDStyleSet* OverrideStyleSet);
+
+	UFUNCTION(BlueprintCallable, Category = "Style Set")
+	void ClearStyleSetOverride(UMDStyleSet* StyleSet);
+
+	UFUNCTION(BlueprintCallable, Category = "Style Set")
+	void ClearAllStyleSetOverrides();
+
+	// Returns the Style Set that's used in place of StyleSet, or StyleSet if it isn't overridden
+	UFUNCTION(BlueprintPure, Category = "Style Set")
+	UMDStyleSet* ResolveStyleSet(UMDStyleSet* StyleSet) const;
+
+	// Widgets are registered once when they're initialized and tracked until they're destroyed, including while they aren't constructed
+	void RegisterWidget(UUserWidget* Widget, const UMDStyleSetWidgetClassExtension* Extension);
+
+private:
+	struct FRegisteredClass
+	{
+		TWeakObjectPtr<const UMDStyleSetWidgetClassExtension> Extension;
+		// A set so registering and unregistering stay cheap with many instances, e.g. list view entries
+		TSet<TWeakObjectPtr<UUserWidget>> Widgets;
+		int32 NumWidgetsAfterPrune = 0;
+	};
+
+	struct FPendingWidget
+	{
+		TWeakObjectPtr<UUserWidget> Widget;
+		TWeakObjectPtr<const UMDStyleSetWidgetClassExtension> Extension;
+		TArray<int32> BindingIndices;
+	};
+
+	// Removes the widgets that were destroyed
+	static void PruneWidgets(FRegisteredClass& RegisteredClass);
+
+	void OnStyleSetResolveChanged(UMDStyleSet* StyleSet, const UMDStyleSet* PreviousStyleSet);
+
+	// When bOnlyChangedValues is set, properties that already have the style value aren't written to and their widget isn't synchronized
+	void ApplyBindings(UUserWidget* Widget, const UMDStyleSetWidgetClassExtension& Extension, TConstArrayView<int32> BindingIndices, bool bOnlyChangedValues = false) const;
+
+#if WITH_EDITOR
+	// Patches live widgets when a Style Set is edited during Play-In-Editor, without recompiling their blueprints
+	void OnStyleSetEdited(UMDStyleSet* StyleSet);
+#endif
+
+	bool ApplyPendingWidgets(float DeltaTime);
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UMDStyleSet>, TObjectPtr<UMDStyleSet>> StyleSetOverrides;
+
+	TMap<FObjectKey, FRegisteredClass> RegisteredClasses;
+
+	TArray<FPendingWidget> PendingWidgets;
+	int32 NextPendingWidgetIndex = 0;
+
+	FTSTicker::FDelegateHandle ApplyTickerHandle;
+
+#if WITH_EDITOR
+	FDelegateHandle StyleSetEditedHandle;
+#endif
+};
@@ -6,6 +6,8 @@
 #include "Templates/SubclassOf.h"
 #include "UObject/Object.h"
 #include "UObject/StrongObjectPtr.h"
+#include "Util/MDStyleSetConversionTable.h"
+#include "Util/MDStyleValueView.h"
 #include "Widgets/SCompoundWidget.h"
 #include "MDStyleSetTypeHandlerBase.generated.h"
 
@@ -37,6 +39,13 @@ class MDSTYLESETS_API UMDStyleSetTypeHandlerBase : public UObject
 public:
 	virtual void GetConvertibleTypes(TArray<FPropertyBagPropertyDesc>& OutConvertibleTypes) const {}
 
+	// Convert the style value to the type described by DestDesc, the default implementation forwards to the legacy TrySetValue
+	virtual bool TrySetStyleValue(const FMDStyleValueView& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const;
+
+	// Return a kernel that converts values of SourceType to DestType, Style Sets cache the kernels of each convertible type so values don't need to go through TrySetStyleValue
+	virtual FMDStyleSetConversionKernel GetConversionKernel(const FMDStyleSetTypeKey& SourceType, const FMDStyleSetTypeKey& DestType) const { return nullptr; }
+
+	// Legacy version of TrySetStyleValue, which copies the property desc of every value
 	virtual bool TrySetValue(const TTuple<FPropertyBagPropertyDesc, const uint8*>& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const { return false; }
 
 	virtual TSharedRef<SWidget> CreateValuePreviewWidget(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag) const;
@@ -16,6 +16,9 @@ class MDSTYLESETS_API UMDStyleSetTypeHandler_Numeric : public UMDStyleSetTypeHan
 public:
 	virtual void GetConvertibleTypes(TArray<FPropertyBagPropertyDesc>& OutConvertibleTypes) const override;
 
+	virtual FMDStyleSetConversionKernel GetConversionKernel(const FMDStyleSetTypeKey& SourceType, const FMDStyleSetTypeKey& DestType) const override;
+
+	virtual bool TrySetStyleValue(const FMDStyleValueView& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const override;
 	virtual bool TrySetValue(const TTuple<FPropertyBagPropertyDesc, const uint8*>& Value, const FPropertyBagPropertyDesc& DestDesc, void* DestPtr) const override;
 
 	virtual FText CreateValuePreviewText_Implementation(UMDStyleSet* StyleSet, const FGameplayTag& StyleTag) const override;
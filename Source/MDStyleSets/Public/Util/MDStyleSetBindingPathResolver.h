@@ -0,0 +1,37 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "PropertyBindingPath.h"
+#include "Util/MDStyleSetTypes.h"
+
+/**
+ * Resolves binding paths from the same base value, sharing the resolution of their common parent segments through a trie.
+ * Bindings to deep struct paths (e.g. WidgetStyle.Normal.TintColor) only resolve their shared parents once.
+ */
+class MDSTYLESETS_API FMDStyleSetBindingPathResolver
+{
+public:
+	explicit FMDStyleSetBindingPathResolver(FPropertyBindingDataView BaseView);
+
+	// Resolves the property the path points to, OutError is set if the path couldn't be resolved.
+	// The target is expected to be written right away, which can reallocate the values under it, so the resolution of paths going through it is forgotten.
+	FMDStyleSetBindingTarget Resolve(const FPropertyBindingPath& Path, FString* OutError = nullptr);
+
+	static FMDStyleSetBindingTarget ResolveFromView(const FPropertyBindingDataView& View, const FPropertyBindingPath& Path, FString* OutError = nullptr);
+
+private:
+	struct FNode
+	{
+		FPropertyBindingDataView View;
+		TMap<TPair<FName, int32>, int32> Children;
+	};
+
+	// Returns the node of the value Segment points to from the parent node, or INDEX_NONE if the value can't be resolved or descended into
+	int32 FindOrAddChild(int32 ParentIndex, const FPropertyBindingPathSegment& Segment);
+
+	// Forgets the values resolved through the property Segment points to, for any array index
+	void RemoveChildren(int32 ParentIndex, const FPropertyBindingPathSegment& Segment);
+
+	TArray<FNode> Nodes;
+};
@@ -0,0 +1,59 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "PropertyBag.h"
+
+// Converts a style value at Source into the value of DestProp at Dest, returns false if the value couldn't be converted
+using FMDStyleSetConversionKernel = bool(*)(const FProperty* DestProp, const uint8* Source, void* Dest);
+
+/**
+ * Lightweight description of a style value's type, cheaper to build from a property than a full FPropertyBagPropertyDesc
+ */
+struct MDSTYLESETS_API FMDStyleSetTypeKey
+{
+public:
+	static FMDStyleSetTypeKey FromProperty(const FProperty* Property);
+	static FMDStyleSetTypeKey FromDesc(const FPropertyBagPropertyDesc& Desc);
+
+	bool IsValid() const { return ValueType != EPropertyBagPropertyType::None; }
+
+	bool operator==(const FMDStyleSetTypeKey& Other) const
+	{
+		return ValueType == Other.ValueType && ContainerType == Other.ContainerType && ValueTypeObject == Other.ValueTypeObject;
+	}
+
+	bool operator!=(const FMDStyleSetTypeKey& Other) const { return !(*this == Other); }
+
+	EPropertyBagPropertyType ValueType = EPropertyBagPropertyType::None;
+	EPropertyBagContainerType ContainerType = EPropertyBagContainerType::None;
+	const UObject* ValueTypeObject = nullptr;
+};
+
+/**
+ * The conversion kernels from a Style Set's style type to each type it can be converted to, resolved once when the Style Set's lookup table is built.
+ * Style Sets only convert to a handful of types so the kernels are kept in a flat array.
+ */
+struct MDSTYLESETS_API FMDStyleSetConversionTable
+{
+public:
+	void Reset();
+
+	void SetSourceDesc(const FPropertyBagPropertyDesc* Desc);
+	void AddKernel(const FMDStyleSetTypeKey& DestKey, FMDStyleSetConversionKernel Kernel);
+
+	// The desc of the values the kernels convert from
+	const FPropertyBagPropertyDesc* GetSourceDesc() const { return SourceDesc; }
+
+	FMDStyleSetConversionKernel FindKernel(const FMDStyleSetTypeKey& DestKey) const;
+
+	SIZE_T GetAllocatedSize() const { return Kernels.GetAllocatedSize(); }
+
+	// Kernel that copies a value of the exact same type
+	static bool CopyValue(const FProperty* DestProp, const uint8* Source, void* Dest);
+
+private:
+	const FPropertyBagPropertyDesc* SourceDesc = nullptr;
+
+	TArray<TPair<FMDStyleSetTypeKey, FMDStyleSetConversionKernel>> Kernels;
+};
@@ -0,0 +1,42 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "PropertyBag.h"
+
+struct FAssetData;
+
+/**
+ * Compact description of a type a Style Set can be converted to, as stored in the ConvertibleTypesAssetTag asset registry tag.
+ * The type hash is stable between sessions so types can be compared without resolving their type object.
+ */
+struct MDSTYLESETS_API FMDStyleSetConvertibleType
+{
+public:
+	static FMDStyleSetConvertibleType FromDesc(const FPropertyBagPropertyDesc& Desc);
+
+	// Reads the convertible types of a Style Set asset, supports the tags of Style Sets saved before the compact encoding
+	static TArray<FMDStyleSetConvertibleType> FromAssetData(const FAssetData& Asset);
+
+	static FString EncodeTagValue(TConstArrayView<FPropertyBagPropertyDesc> Types);
+
+	// Returns false if TagValue isn't in the current encoding
+	static bool DecodeTagValue(FStringView TagValue, TArray<FMDStyleSetConvertibleType>& OutTypes);
+
+	// Resolves the type object, loading it if needed
+	FPropertyBagPropertyDesc ToDesc() const;
+
+	// Same rules as FPropertyBagPropertyDesc::CompatibleType, only object types need their type object resolved
+	bool IsCompatibleWith(const FMDStyleSetConvertibleType& Other) const;
+
+	// Struct and enum types are only compatible with the same type object, other types ignore it except for object class inheritance
+	bool MatchesTypeObjectExactly() const;
+
+	uint32 TypeHash = 0;
+	EPropertyBagPropertyType ValueType = EPropertyBagPropertyType::None;
+	EPropertyBagContainerType ContainerType = EPropertyBagContainerType::None;
+	FSoftObjectPath ValueTypeObjectPath;
+
+private:
+	void UpdateTypeHash();
+};
@@ -0,0 +1,56 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "AssetRegistry/AssetData.h"
+#include "PropertyBag.h"
+#include "Util/MDStyleSetConvertibleType.h"
+
+/**
+ * Index of the types each Style Set asset can be converted to, built from the asset registry tags and kept up to date by asset registry events.
+ * Struct and enum types are bucketed by their type hash and other types by their value and container type, so finding the Style Sets convertible to a type doesn't need to parse every Style Set's tags.
+ */
+class MDSTYLESETS_API FMDStyleSetConvertibleTypeIndex
+{
+public:
+	static FMDStyleSetConvertibleTypeIndex& Get();
+
+	// Unbinds from the asset registry, called on module shutdown
+	static void TearDown();
+
+	~FMDStyleSetConvertibleTypeIndex();
+
+	bool HasConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc) const;
+
+	// Returns the asset data of each Style Set that can be converted to Desc
+	TArray<FAssetData> GetConvertibleStyleSets(const FPropertyBagPropertyDesc& Desc) const;
+
+private:
+	struct FIndexedType
+	{
+		FMDStyleSetConvertibleType Type;
+		FSoftObjectPath StyleSetPath;
+	};
+
+	FMDStyleSetConvertibleTypeIndex();
+
+	void RebuildIndex();
+
+	void AddStyleSet(const FAssetData& AssetData);
+	void RemoveStyleSet(const FSoftObjectPath& StyleSetPath);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	static uint32 GetBucketKey(const FMDStyleSetConvertibleType& Type);
+
+	TMap<FSoftObjectPath, FAssetData> StyleSets;
+	TMap<uint32, TArray<FIndexedType>> TypeBuckets;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle FilesLoadedHandle;
+};
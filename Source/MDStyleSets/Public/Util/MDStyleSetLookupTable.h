@@ -0,0 +1,59 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+struct FPropertyBagPropertyDesc;
+
+/**
+ * Flat index of a Style Set's entries, built once after loading so lookups don't need to hash into the entry map nor search each entry's property bag.
+ * Tags are kept sorted in their own array with the value pointers and property descs stored in parallel arrays.
+ */
+struct MDSTYLESETS_API FMDStyleSetLookupTable
+{
+public:
+	static bool IsSameValueType(const FPropertyBagPropertyDesc& A, const FPropertyBagPropertyDesc& B);
+
+	void Reset();
+
+	// Adds an entry to the table, Finalize must be called once all entries are added
+	void AddEntry(const FGameplayTag& Tag, const FPropertyBagPropertyDesc* Desc, const uint8* Value);
+	void SetFallback(const FPropertyBagPropertyDesc* Desc, const uint8* Value);
+
+	// Sorts the entries and makes the table available for lookups
+	void Finalize();
+
+	// Builds the table from the entries of Overrides and the entries of Base that Overrides doesn't have, without sorting since both tables are already sorted
+	void Merge(const FMDStyleSetLookupTable& Overrides, const FMDStyleSetLookupTable& Base);
+
+	bool IsBuilt() const { return bIsBuilt; }
+	int32 Num() const { return Tags.Num(); }
+
+	int32 FindEntryIndex(const FGameplayTag& Tag) const;
+
+	const FGameplayTag& GetTag(int32 Index) const { return Tags[Index]; }
+	const FPropertyBagPropertyDesc* GetDesc(int32 Index) const { return Descs[Index]; }
+	const uint8* GetValue(int32 Index) const { return Values[Index]; }
+
+	const FPropertyBagPropertyDesc* GetFallbackDesc() const { return FallbackDesc; }
+	const uint8* GetFallbackValue() const { return FallbackValue; }
+
+	// The desc shared by every entry of the set's style type
+	const FPropertyBagPropertyDesc* GetSharedDesc() const { return SharedDesc; }
+
+	SIZE_T GetAllocatedSize() const { return Tags.GetAllocatedSize() + Descs.GetAllocatedSize() + Values.GetAllocatedSize(); }
+
+private:
+	const FPropertyBagPropertyDesc* GetOrAddSharedDesc(const FPropertyBagPropertyDesc* Desc);
+
+	TArray<FGameplayTag> Tags;
+	TArray<const FPropertyBagPropertyDesc*> Descs;
+	TArray<const uint8*> Values;
+
+	const FPropertyBagPropertyDesc* SharedDesc = nullptr;
+	const FPropertyBagPropertyDesc* FallbackDesc = nullptr;
+	const uint8* FallbackValue = nullptr;
+
+	bool bIsBuilt = false;
+};
@@ -5,11 +5,21 @@
 #include "GameplayTagContainer.h"
 #include "PropertyBindingPath.h"
 #include "PropertyPathHelpers.h"
+#include "Util/MDStyleSetConversionTable.h"
+#include "Util/MDStyleValueView.h"
 
 #include "MDStyleSetTypes.generated.h"
 
 class UMDStyleSet;
 
+enum class EMDStyleSetBindingExecutionResult : uint8
+{
+	Success,
+	StyleNotFound,
+	PropertyNotFound,
+	CouldNotSetValue
+};
+
 USTRUCT(BlueprintType)
 struct FMDStyleSetValueReference
 {
@@ -23,6 +33,20 @@ public:
 	FGameplayTag StyleValueTag;
 };
 
+// Same as FMDStyleSetValueReference but doesn't keep the Style Set loaded, use UMDStyleSetFunctionLibrary::GetStyleValueAsync to stream it in
+USTRUCT(BlueprintType)
+struct FMDStyleSetSoftValueReference
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Style Set Value")
+	TSoftObjectPtr<UMDStyleSet> StyleSet;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Style Set Value", meta = (Categories = "Style"))
+	FGameplayTag StyleValueTag;
+};
+
 USTRUCT(BlueprintType)
 struct FMDStyleSetPropertyBinding
 {
@@ -34,4 +58,57 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = "Style Set Value")
 	FPropertyBindingPath TargetProperty;
+
+#if WITH_EDITORONLY_DATA
+	// Version of the style value when it was last written to the target property, 0 if it hasn't been. Unchanged values aren't written again when recompiling.
+	UPROPERTY()
+	uint32 BakedVersion = 0;
+#endif
+};
+
+// The property a binding writes its style value to
+struct FMDStyleSetBindingTarget
+{
+	const FProperty* Property = nullptr;
+	void* Address = nullptr;
+};
+
+// Last value read by a Get Style Value node with a dynamic tag, stored in a variable of the blueprint instance for each node.
+// Only valid while the Style Set's lookup table version is unchanged, base Style Sets rebuilding also rebuild the tables of the Style Sets inheriting from them.
+USTRUCT(BlueprintType, meta = (BlueprintInternalUseOnly = "true"))
+struct MDSTYLESETS_API FMDStyleSetValueCache
+{
+	GENERATED_BODY()
+
+public:
+	FMDStyleSetValueCache() = default;
+
+	// Copies start empty so an instance never uses a value cached by the object it was copied from, e.g. its class defaults
+	FMDStyleSetValueCache(const FMDStyleSetValueCache&) {}
+	FMDStyleSetValueCache& operator=(const FMDStyleSetValueCache&)
+	{
+		Reset();
+		return *this;
+	}
+
+	void Reset()
+	{
+		StyleSet = nullptr;
+		Version = 0;
+		Tag = FGameplayTag();
+		DestProp = nullptr;
+		Value = {};
+		Kernel = nullptr;
+	}
+
+private:
+	friend class UMDStyleSet;
+
+	// Only compared, lookup table versions are unique across Style Sets so a Style Set allocated where a destroyed one was never matches
+	const UMDStyleSet* StyleSet = nullptr;
+	uint32 Version = 0;
+	FGameplayTag Tag;
+	const FProperty* DestProp = nullptr;
+	FMDStyleValueView Value;
+	FMDStyleSetConversionKernel Kernel = nullptr;
 };
@@ -0,0 +1,51 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "PropertyBag.h"
+
+/**
+ * Non-owning view of a style value, points at the Style Set's property desc and the value's memory without copying either.
+ * Only valid until the Style Set's entries are modified.
+ */
+struct FMDStyleValueView
+{
+public:
+	FMDStyleValueView() = default;
+
+	FMDStyleValueView(const FPropertyBagPropertyDesc* InDesc, const uint8* InMemory)
+		: Desc(InDesc)
+		, Memory(InDesc != nullptr ? InMemory : nullptr)
+	{}
+
+	bool IsValid() const { return Desc != nullptr && Memory != nullptr; }
+
+	const FPropertyBagPropertyDesc* GetPropertyDesc() const { return Desc; }
+	const uint8* GetMemory() const { return Memory; }
+
+	const FProperty* GetProperty() const { return Desc != nullptr ? Desc->CachedProperty : nullptr; }
+	EPropertyBagPropertyType GetValueType() const { return Desc != nullptr ? Desc->ValueType : EPropertyBagPropertyType::None; }
+	const UObject* GetValueTypeObject() const { return Desc != nullptr ? Desc->ValueTypeObject.Get() : nullptr; }
+
+	template<typename T>
+	const T& Get() const
+	{
+		check(Memory != nullptr);
+		return *reinterpret_cast<const T*>(Memory);
+	}
+
+	// Copies the desc into the tuple format used by the older style value API
+	TTuple<FPropertyBagPropertyDesc, const uint8*> ToTuple() const
+	{
+		if (Desc != nullptr)
+		{
+			return { *Desc, Memory };
+		}
+
+		return {};
+	}
+
+private:
+	const FPropertyBagPropertyDesc* Desc = nullptr;
+	const uint8* Memory = nullptr;
+};
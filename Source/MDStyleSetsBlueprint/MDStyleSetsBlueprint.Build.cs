@@ -28,6 +28,7 @@ public class MDStyleSetsBlueprint : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "GameplayTags",
+                "Json",
                 "Slate",
                 "SlateCore",
                 "UMGEditor",
@@ -0,0 +1,291 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Commandlets/MDStyleSetRebakeCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
+#include "Blueprint/WidgetTree.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "Extensions/MDStyleSetBlueprintExtension.h"
+#include "HAL/FileManager.h"
+#include "MDStyleSet.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/ObjectWriter.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Util/MDStyleSetBindingIndex.h"
+#include "WidgetBlueprint.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMDStyleSetRebake, Log, All);
+
+namespace MDSSRC
+{
+	const TCHAR* LexToString(EMDStyleSetBindingExecutionResult Result)
+	{
+		switch (Result)
+		{
+		case EMDStyleSetBindingExecutionResult::Success:
+			return TEXT("Success");
+		case EMDStyleSetBindingExecutionResult::StyleNotFound:
+			return TEXT("StyleNotFound");
+		case EMDStyleSetBindingExecutionResult::PropertyNotFound:
+			return TEXT("PropertyNotFound");
+		case EMDStyleSetBindingExecutionResult::CouldNotSetValue:
+			return TEXT("CouldNotSetValue");
+		}
+
+		return TEXT("Unknown");
+	}
+
+	// Every object the bindings of the blueprint can write to
+	TArray<UObject*> GatherBakedObjects(UBlueprint* Blueprint)
+	{
+		TArray<UObject*> Objects = { Blueprint->GeneratedClass->GetDefaultObject() };
+
+		if (UWidgetBlueprint* WidgetBP = Cast<UWidgetBlueprint>(Blueprint))
+		{
+			Objects.Append(WidgetBP->GetAllSourceWidgets());
+		}
+
+		if (const UWidgetBlueprintGeneratedClass* WidgetClass = Cast<UWidgetBlueprintGeneratedClass>(Blueprint->GeneratedClass))
+		{
+			if (UWidgetTree* WidgetTree = WidgetClass->GetWidgetTreeArchetype())
+			{
+				WidgetTree->ForEachWidget([&Objects](UWidget* Widget)
+				{
+					Objects.Add(Widget);
+				});
+			}
+		}
+
+		return Objects;
+	}
+
+	TArray<TArray<uint8>> SerializeObjects(TConstArrayView<UObject*> Objects)
+	{
+		TArray<TArray<uint8>> Result;
+		Result.SetNum(Objects.Num());
+
+		for (int32 i = 0; i < Objects.Num(); ++i)
+		{
+			if (IsValid(Objects[i]))
+			{
+				FObjectWriter Writer(Objects[i], Result[i]);
+			}
+		}
+
+		return Result;
+	}
+
+	bool SaveBlueprintPackage(UBlueprint* Blueprint, FString& OutError)
+	{
+		UPackage* Package = Blueprint->GetPackage();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		if (IFileManager::Get().IsReadOnly(*Filename))
+		{
+			OutError = FString::Printf(TEXT("[%s] is read only"), *Filename);
+			return false;
+		}
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.Error = GWarn;
+		if (!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+		{
+			OutError = FString::Printf(TEXT("Failed to save [%s]"), *Filename);
+			return false;
+		}
+
+		return true;
+	}
+}
+
+UMDStyleSetRebakeCommandlet::UMDStyleSetRebakeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UMDStyleSetRebakeCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const bool bDryRun = Switches.Contains(TEXT("DryRun"));
+	const bool bAllBlueprints = Switches.Contains(TEXT("AllBlueprints"));
+	const FString* BatchSizeParam = ParamValues.Find(TEXT("BatchSize"));
+	const int32 BatchSize = BatchSizeParam != nullptr ? FMath::Max(1, FCString::Atoi(**BatchSizeParam)) : 32;
+	const FString* ReportParam = ParamValues.Find(TEXT("Report"));
+	const FString ReportPath = ReportParam != nullptr ? *ReportParam : FPaths::ProjectSavedDir() / TEXT("MDStyleSets") / TEXT("RebakeReport.json");
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	if (bAllBlueprints)
+	{
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+	}
+	else
+	{
+		Filter.TagsAndValues.Add(FMDStyleSetBindingIndex::BindingsAssetTagName, TOptional<FString>());
+	}
+
+	TArray<FAssetData> BlueprintAssets;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+	if (!bAllBlueprints)
+	{
+		// The tag also lists the style values read by nodes and variables, which have nothing to re-bake
+		BlueprintAssets.RemoveAll([](const FAssetData& BlueprintAsset) { return !FMDStyleSetBindingIndex::HasBindings(BlueprintAsset); });
+	}
+
+	UE_LOG(LogMDStyleSetRebake, Display, TEXT("Re-baking the style bindings of %d blueprints in batches of %d%s"), BlueprintAssets.Num(), BatchSize, bDryRun ? TEXT(" (dry run)") : TEXT(""));
+
+	TArray<TSharedPtr<FJsonValue>> BlueprintReports;
+	int32 NumRebaked = 0;
+	int32 NumSaved = 0;
+	int32 NumFailed = 0;
+
+	for (int32 BatchStart = 0; BatchStart < BlueprintAssets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, BlueprintAssets.Num());
+
+		// Requesting the whole batch before waiting lets the async loader read and deserialize the packages in parallel, the bindings are then applied on the game thread
+		const double LoadStartTime = FPlatformTime::Seconds();
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			LoadPackageAsync(BlueprintAssets[i].PackageName.ToString());
+		}
+
+		FlushAsyncLoading();
+		const double BatchLoadSeconds = FPlatformTime::Seconds() - LoadStartTime;
+
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			const FAssetData& BlueprintAsset = BlueprintAssets[i];
+			UBlueprint* Blueprint = Cast<UBlueprint>(BlueprintAsset.FastGetAsset(false));
+			UMDStyleSetBlueprintExtension* BPExtension = UMDStyleSetBlueprintExtension::GetExtension(Blueprint);
+			if (bAllBlueprints && IsValid(Blueprint) && !IsValid(BPExtension))
+			{
+				continue;
+			}
+
+			TSharedRef<FJsonObject> BlueprintReport = MakeShared<FJsonObject>();
+			BlueprintReport->SetStringField(TEXT("blueprint"), BlueprintAsset.GetObjectPathString());
+			BlueprintReport->SetNumberField(TEXT("batchLoadSeconds"), BatchLoadSeconds);
+			BlueprintReports.Add(MakeShared<FJsonValueObject>(BlueprintReport));
+
+			if (!IsValid(Blueprint) || !IsValid(Blueprint->GeneratedClass))
+			{
+				UE_LOG(LogMDStyleSetRebake, Error, TEXT("Failed to load [%s]"), *BlueprintAsset.GetObjectPathString());
+				BlueprintReport->SetStringField(TEXT("error"), TEXT("Failed to load"));
+				++NumFailed;
+				continue;
+			}
+
+			const double RebakeStartTime = FPlatformTime::Seconds();
+			const TArray<UObject*> BakedObjects = MDSSRC::GatherBakedObjects(Blueprint);
+			const TArray<TArray<uint8>> ValuesBefore = MDSSRC::SerializeObjects(BakedObjects);
+
+			TArray<EMDStyleSetBindingExecutionResult> Results;
+			if (!FMDStyleSetBindingIndex::RebakeBlueprint(Blueprint, &Results))
+			{
+				BlueprintReport->SetBoolField(TEXT("changed"), false);
+				continue;
+			}
+
+			const bool bChanged = MDSSRC::SerializeObjects(BakedObjects) != ValuesBefore;
+			BlueprintReport->SetNumberField(TEXT("rebakeSeconds"), FPlatformTime::Seconds() - RebakeStartTime);
+			BlueprintReport->SetBoolField(TEXT("changed"), bChanged);
+			++NumRebaked;
+
+			TArray<TSharedPtr<FJsonValue>> FailedBindings;
+			for (int32 BindingIdx = 0; BindingIdx < Results.Num() && BindingIdx < BPExtension->Bindings.Num(); ++BindingIdx)
+			{
+				if (Results[BindingIdx] == EMDStyleSetBindingExecutionResult::Success)
+				{
+					continue;
+				}
+
+				const FMDStyleSetPropertyBinding& Binding = BPExtension->Bindings[BindingIdx];
+				TSharedRef<FJsonObject> FailedBinding = MakeShared<FJsonObject>();
+				FailedBinding->SetStringField(TEXT("property"), Binding.TargetProperty.ToString());
+				FailedBinding->SetStringField(TEXT("styleSet"), GetPathNameSafe(Binding.Value.StyleSet));
+				FailedBinding->SetStringField(TEXT("tag"), Binding.Value.StyleValueTag.ToString());
+				FailedBinding->SetStringField(TEXT("result"), MDSSRC::LexToString(Results[BindingIdx]));
+				FailedBindings.Add(MakeShared<FJsonValueObject>(FailedBinding));
+
+				UE_LOG(LogMDStyleSetRebake, Warning, TEXT("[%s] Binding of [%s] to [%s] failed with [%s]"), *BlueprintAsset.GetObjectPathString(), *Binding.TargetProperty.ToString(), *Binding.Value.StyleValueTag.ToString(), MDSSRC::LexToString(Results[BindingIdx]));
+			}
+
+			BlueprintReport->SetArrayField(TEXT("failedBindings"), FailedBindings);
+
+			bool bFailed = !FailedBindings.IsEmpty();
+			if (bChanged && !bDryRun)
+			{
+				const double SaveStartTime = FPlatformTime::Seconds();
+				FString SaveError;
+				const bool bSaved = MDSSRC::SaveBlueprintPackage(Blueprint, SaveError);
+				BlueprintReport->SetNumberField(TEXT("saveSeconds"), FPlatformTime::Seconds() - SaveStartTime);
+				BlueprintReport->SetBoolField(TEXT("saved"), bSaved);
+				if (bSaved)
+				{
+					UE_LOG(LogMDStyleSetRebake, Display, TEXT("Saved re-baked [%s]"), *BlueprintAsset.GetObjectPathString());
+					++NumSaved;
+				}
+				else
+				{
+					UE_LOG(LogMDStyleSetRebake, Error, TEXT("%s"), *SaveError);
+					BlueprintReport->SetStringField(TEXT("error"), SaveError);
+					bFailed = true;
+				}
+			}
+
+			if (bFailed)
+			{
+				++NumFailed;
+			}
+		}
+
+		// Keep memory bounded by only holding on to one batch at a time
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetBoolField(TEXT("dryRun"), bDryRun);
+	Report->SetNumberField(TEXT("totalSeconds"), TotalSeconds);
+	Report->SetNumberField(TEXT("numBlueprints"), BlueprintReports.Num());
+	Report->SetNumberField(TEXT("numRebaked"), NumRebaked);
+	Report->SetNumberField(TEXT("numSaved"), NumSaved);
+	Report->SetNumberField(TEXT("numFailed"), NumFailed);
+	Report->SetArrayField(TEXT("blueprints"), BlueprintReports);
+
+	FString ReportString;
+	const TSharedRef<TJsonWriter<>> ReportWriter = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(Report, ReportWriter);
+	if (!FFileHelper::SaveStringToFile(ReportString, *ReportPath))
+	{
+		UE_LOG(LogMDStyleSetRebake, Error, TEXT("Failed to write the report to [%s]"), *ReportPath);
+	}
+
+	UE_LOG(LogMDStyleSetRebake, Display, TEXT("Re-baked %d blueprints, saved %d, %d failed, in %.2f seconds. Report written to [%s]"), NumRebaked, NumSaved, NumFailed, TotalSeconds, *ReportPath);
+
+	return NumFailed > 0 ? 1 : 0;
+}
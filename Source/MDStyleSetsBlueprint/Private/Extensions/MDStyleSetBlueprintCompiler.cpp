@@ -5,35 +5,183 @@
 
 #include "Editor.h"
 #include "Extensions/MDStyleSetBlueprintExtension.h"
+#include "Extensions/MDStyleSetWidgetBlueprintExtension.h"
 #include "MDStyleSet.h"
+#include "Util/MDStyleSetBindingPathResolver.h"
+#include "Util/MDStyleSetBlueprintPreloader.h"
 #include "WidgetBlueprintCompiler.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogMDStyleSetCompiler, Warning, All);
 
-EMDStyleSetBindingExecutionResult UMDStyleSetBlueprintCompiler::ExecuteBindingOnBlueprint(UBlueprint* Blueprint, const FPropertyBindingDataView BaseValueView, const FMDStyleSetPropertyBinding& Binding)
+namespace MDSSBC
 {
-	if (!IsValid(Binding.Value.StyleSet))
+	void LogBindingResult(UBlueprint* Blueprint, const FMDStyleSetPropertyBinding& Binding, EMDStyleSetBindingExecutionResult Result)
 	{
-		UE_LOG(LogMDStyleSetCompiler, Error, TEXT("Error executing binding BP: [%s] | Property: [%s] | Error: [Invalid StyleSet]"), *GetNameSafe(Blueprint), *Binding.TargetProperty.ToString());
-		return EMDStyleSetBindingExecutionResult::StyleNotFound;
-	}
+		if (Result != EMDStyleSetBindingExecutionResult::StyleNotFound)
+		{
+			return;
+		}
 
-	if (Binding.Value.StyleSet->HasAnyFlags(RF_NeedLoad))
-	{
-		Binding.Value.StyleSet->GetLinker()->Preload(Binding.Value.StyleSet);
+		if (!IsValid(Binding.Value.StyleSet))
+		{
+			UE_LOG(LogMDStyleSetCompiler, Error, TEXT("Error executing binding BP: [%s] | Property: [%s] | Error: [Invalid StyleSet]"), *GetNameSafe(Blueprint), *Binding.TargetProperty.ToString());
+		}
+		else
+		{
+			UE_LOG(LogMDStyleSetCompiler, Error, TEXT("Error executing binding BP: [%s] | Property: [%s] | StyleSet [%s] does not have value for tag [%s]"), *GetNameSafe(Blueprint), *Binding.TargetProperty.ToString(), *Binding.Value.StyleSet->GetDisplayName().ToString(), *Binding.Value.StyleValueTag.ToString());
+		}
 	}
 
-	if (Binding.Value.StyleSet->HasAnyFlags(RF_NeedPostLoad))
+	// Version of the value the binding writes, 0 if it can't be written
+	uint32 GetBakeVersion(const UWidgetBlueprint* WidgetBP, const FMDStyleSetPropertyBinding& Binding)
 	{
-		Binding.Value.StyleSet->ConditionalPostLoad();
+		if (!IsValid(Binding.Value.StyleSet))
+		{
+			return 0;
+		}
+
+		uint32 Version = Binding.Value.StyleSet->GetEntryVersion(Binding.Value.StyleValueTag);
+
+		// A widget that's deleted then re-added with the same name gets a new guid, so its default values don't count as baked
+		if (WidgetBP != nullptr && Binding.TargetProperty.NumSegments() > 0)
+		{
+			if (const FGuid* WidgetGuid = WidgetBP->WidgetVariableNameToGuidMap.Find(Binding.TargetProperty.GetSegment(0).GetName()))
+			{
+				Version = HashCombineFast(Version, GetTypeHash(*WidgetGuid));
+			}
+		}
+
+		return Version != 0 ? Version : 1;
 	}
+}
+
+EMDStyleSetBindingExecutionResult UMDStyleSetBlueprintCompiler::ExecuteBindingOnBlueprint(UBlueprint* Blueprint, const FPropertyBindingDataView BaseValueView, const FMDStyleSetPropertyBinding& Binding)
+{
+	FMDStyleSetBlueprintPreloader::PreloadStyleSet(Binding.Value.StyleSet);
+
+	const FMDStyleSetBindingTarget Target = ResolveBindingTarget(Blueprint, BaseValueView, Binding);
 
-	if (!Binding.Value.StyleSet->DoesHaveValueWithTag(Binding.Value.StyleValueTag))
+	EMDStyleSetBindingExecutionResult Result = EMDStyleSetBindingExecutionResult::CouldNotSetValue;
+	UMDStyleSet::ApplyBindings(MakeArrayView(&Binding, 1), [&Target](int32) { return Target; }, MakeArrayView(&Result, 1));
+	MDSSBC::LogBindingResult(Blueprint, Binding, Result);
+
+	return Result;
+}
+
+void UMDStyleSetBlueprintCompiler::ExecuteBindingsOnBlueprint(UBlueprint* Blueprint, UMDStyleSetBlueprintExtension* BPExtension, bool bShouldRemoveFailedBindings, TArray<EMDStyleSetBindingExecutionResult>* OutResults)
+{
+	if (IsValid(Blueprint) && IsValid(BPExtension))
 	{
-		UE_LOG(LogMDStyleSetCompiler, Error, TEXT("Error executing binding BP: [%s] | Property: [%s] | StyleSet [%s] does not have value for tag [%s]"), *GetNameSafe(Blueprint), *Binding.TargetProperty.ToString(), *Binding.Value.StyleSet->GetDisplayName().ToString(), *Binding.Value.StyleValueTag.ToString());
-		return EMDStyleSetBindingExecutionResult::StyleNotFound;
+		UObject* CDO = Blueprint->GeneratedClass->GetDefaultObject();
+
+		// Bindings share the resolution of their common parent properties, and widgets are found by name once rather than scanning every widget per binding
+		FMDStyleSetBindingPathResolver CDOResolver(CDO);
+		TMap<FName, UWidget*> SourceWidgets;
+		TMap<UWidget*, FMDStyleSetBindingPathResolver> WidgetResolvers;
+		UWidgetBlueprint* WidgetBP = Cast<UWidgetBlueprint>(Blueprint);
+		if (WidgetBP != nullptr)
+		{
+			for (UWidget* Widget : WidgetBP->GetAllSourceWidgets())
+			{
+				if (IsValid(Widget))
+				{
+					SourceWidgets.Add(Widget->GetFName(), Widget);
+				}
+			}
+		}
+
+		TSet<UMDStyleSet*> PreloadedStyleSets;
+		for (const FMDStyleSetPropertyBinding& Binding : BPExtension->Bindings)
+		{
+			bool bIsAlreadyPreloaded = false;
+			PreloadedStyleSets.Add(Binding.Value.StyleSet, &bIsAlreadyPreloaded);
+			if (!bIsAlreadyPreloaded)
+			{
+				FMDStyleSetBlueprintPreloader::PreloadStyleSet(Binding.Value.StyleSet);
+			}
+		}
+
+		// Targets that already have the current version of their style value aren't written again, they're still resolved so missing properties are found.
+		// This assumes the CDO and widgets still hold the baked value, a bound property edited by hand keeps its value until its style value changes.
+		TArray<uint32> BakeVersions;
+		TBitArray<> SkippedBindings(false, BPExtension->Bindings.Num());
+		BakeVersions.Reserve(BPExtension->Bindings.Num());
+		for (const FMDStyleSetPropertyBinding& Binding : BPExtension->Bindings)
+		{
+			BakeVersions.Add(MDSSBC::GetBakeVersion(WidgetBP, Binding));
+		}
+
+		auto ResolveTarget = [&](int32 BindingIndex)
+		{
+			const FMDStyleSetPropertyBinding& Binding = BPExtension->Bindings[BindingIndex];
+
+			FString Error;
+			FMDStyleSetBindingTarget Target = CDOResolver.Resolve(Binding.TargetProperty, &Error);
+
+			// Widgets that aren't variables don't exist on the CDO, resolve the rest of the path on the widget instead
+			UWidget* const* SourceWidget = (Target.Property == nullptr && Binding.TargetProperty.NumSegments() > 1) ? SourceWidgets.Find(Binding.TargetProperty.GetSegment(0).GetName()) : nullptr;
+			if (SourceWidget != nullptr)
+			{
+				FPropertyBindingPath TrimmedPath;
+				for (int32 i = 1; i < Binding.TargetProperty.NumSegments(); ++i)
+				{
+					TrimmedPath.AddPathSegment(Binding.TargetProperty.GetSegment(i));
+				}
+
+				FMDStyleSetBindingPathResolver* WidgetResolver = WidgetResolvers.Find(*SourceWidget);
+				if (WidgetResolver == nullptr)
+				{
+					WidgetResolver = &WidgetResolvers.Add(*SourceWidget, FMDStyleSetBindingPathResolver(*SourceWidget));
+				}
+
+				Error.Reset();
+				Target = WidgetResolver->Resolve(TrimmedPath, &Error);
+			}
+
+			UE_CLOG(Target.Property == nullptr && !Error.IsEmpty(), LogMDStyleSetCompiler, Error, TEXT("Error executing binding BP: [%s] | Property: [%s] | Error: [%s]"), *GetNameSafe(Blueprint), *Binding.TargetProperty.ToString(), *Error);
+
+			if (Target.Property != nullptr && Binding.BakedVersion != 0 && Binding.BakedVersion == BakeVersions[BindingIndex])
+			{
+				SkippedBindings[BindingIndex] = true;
+				return FMDStyleSetBindingTarget();
+			}
+
+			return Target;
+		};
+
+		// Each target is resolved right before it's written, writing a container property can reallocate the values a later binding's path goes through
+		TArray<EMDStyleSetBindingExecutionResult> Results;
+		Results.SetNumZeroed(BPExtension->Bindings.Num());
+		UMDStyleSet::ApplyBindings(BPExtension->Bindings, ResolveTarget, Results);
+
+		// Skipped bindings still report tags missing from their Style Set
+		for (TConstSetBitIterator<> It(SkippedBindings); It; ++It)
+		{
+			const FMDStyleSetValueReference& Value = BPExtension->Bindings[It.GetIndex()].Value;
+			Results[It.GetIndex()] = Value.StyleSet->DoesHaveValueWithTag(Value.StyleValueTag) ? EMDStyleSetBindingExecutionResult::Success : EMDStyleSetBindingExecutionResult::StyleNotFound;
+		}
+
+		for (int32 i = BPExtension->Bindings.Num() - 1; i >= 0; --i)
+		{
+			BPExtension->Bindings[i].BakedVersion = Results[i] == EMDStyleSetBindingExecutionResult::Success ? BakeVersions[i] : 0;
+			MDSSBC::LogBindingResult(Blueprint, BPExtension->Bindings[i], Results[i]);
+			if (bShouldRemoveFailedBindings && Results[i] == EMDStyleSetBindingExecutionResult::PropertyNotFound)
+			{
+				BPExtension->Bindings.RemoveAt(i);
+			}
+		}
+
+		BPExtension->RebuildBindingIndex();
+
+		if (OutResults != nullptr)
+		{
+			*OutResults = MoveTemp(Results);
+		}
 	}
+}
 
+FMDStyleSetBindingTarget UMDStyleSetBlueprintCompiler::ResolveBindingTarget(UBlueprint* Blueprint, const FPropertyBindingDataView BaseValueView, const FMDStyleSetPropertyBinding& Binding)
+{
 	FString Error;
 	TArray<FPropertyBindingPathIndirection> Indirections;
 	if (Binding.TargetProperty.ResolveIndirectionsWithValue(BaseValueView, Indirections, &Error, true) && !Indirections.IsEmpty())
@@ -65,31 +213,14 @@ EMDStyleSetBindingExecutionResult UMDStyleSetBlueprintCompiler::ExecuteBindingOn
 
 	UE_CLOG(!Error.IsEmpty(), LogMDStyleSetCompiler, Error, TEXT("Error executing binding BP: [%s] | Property: [%s] | Error: [%s]"), *GetNameSafe(Blueprint), *Binding.TargetProperty.ToString(), *Error);
 
-	if (Indirections.IsEmpty() || Indirections.Last().GetContainerAddress() == nullptr)
+	FMDStyleSetBindingTarget Target;
+	if (!Indirections.IsEmpty() && Indirections.Last().GetContainerAddress() != nullptr)
 	{
-		return EMDStyleSetBindingExecutionResult::PropertyNotFound;
+		Target.Property = Indirections.Last().GetProperty();
+		Target.Address = Indirections.Last().GetMutablePropertyAddress();
 	}
 
-	const FProperty* Property = Indirections.Last().GetProperty();
-	void* TargetAddress = Indirections.Last().GetMutablePropertyAddress();
-	const bool bDidSetValue = Binding.Value.StyleSet->TrySetPropertyValue(Binding.Value.StyleValueTag, Property, TargetAddress);
-
-	return bDidSetValue ? EMDStyleSetBindingExecutionResult::Success : EMDStyleSetBindingExecutionResult::CouldNotSetValue;
-}
-
-void UMDStyleSetBlueprintCompiler::ExecuteBindingsOnBlueprint(UBlueprint* Blueprint, UMDStyleSetBlueprintExtension* BPExtension, bool bShouldRemoveFailedBindings)
-{
-	if (IsValid(Blueprint) && IsValid(BPExtension))
-	{
-		for (auto It = BPExtension->Bindings.CreateIterator(); It; ++It)
-		{
-			const EMDStyleSetBindingExecutionResult Result = ExecuteBindingOnBlueprint(Blueprint, Blueprint->GeneratedClass->GetDefaultObject(), *It);
-			if (bShouldRemoveFailedBindings && Result == EMDStyleSetBindingExecutionResult::PropertyNotFound)
-			{
-				It.RemoveCurrent();
-			}
-		}
-	}
+	return Target;
 }
 
 void UMDStyleSetBlueprintCompiler::BeginDestroy()
@@ -118,6 +249,11 @@ void UMDStyleSetBlueprintCompiler::OnBlueprintPreCompile(UBlueprint* Blueprint)
 {
 	if (IsValid(Blueprint))
 	{
+		// Finish loading every Style Set the blueprint uses up front, rather than as each binding and node needs them
+		TSet<UMDStyleSet*> StyleSets;
+		FMDStyleSetBlueprintPreloader::GatherStyleSets(Blueprint, StyleSets);
+		FMDStyleSetBlueprintPreloader::PreloadStyleSets(StyleSets);
+
 		UMDStyleSetBlueprintExtension* BPExtension = UMDStyleSetBlueprintExtension::GetExtension(Blueprint);
 		if (!IsValid(BPExtension))
 		{
@@ -129,8 +265,20 @@ void UMDStyleSetBlueprintCompiler::OnBlueprintPreCompile(UBlueprint* Blueprint)
 		}
 		else if (Blueprint->GeneratedClass != nullptr)
 		{
+			if (UWidgetBlueprint* WidgetBP = Cast<UWidgetBlueprint>(Blueprint))
+			{
+				UWidgetBlueprintExtension::RequestExtension<UMDStyleSetWidgetBlueprintExtension>(WidgetBP);
+			}
+
+			// The baked values are saved with the blueprint, so they're already up to date if it wasn't modified since loading and neither the bindings nor their Style Sets changed
+			if (!Blueprint->GetPackage()->IsDirty() && !BPExtension->BakedContentHash.IsEmpty() && BPExtension->BakedContentHash == BPExtension->CalculateContentHash())
+			{
+				return;
+			}
+
 			constexpr bool bShouldRemoveFailedBindings = true;
 			ExecuteBindingsOnBlueprint(Blueprint, BPExtension, bShouldRemoveFailedBindings);
+			BPExtension->BakedContentHash = BPExtension->CalculateContentHash();
 		}
 	}
 }
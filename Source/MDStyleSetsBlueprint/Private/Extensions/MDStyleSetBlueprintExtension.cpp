@@ -5,8 +5,11 @@
 #include "BlueprintCompilationManager.h"
 #include "Engine/Blueprint.h"
 #include "Extensions/MDStyleSetBlueprintCompiler.h"
+#include "Extensions/MDStyleSetWidgetBlueprintExtension.h"
+#include "Hash/Blake3.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "MDStyleSet.h"
+#include "WidgetBlueprint.h"
 
 UMDStyleSetBlueprintExtension* UMDStyleSetBlueprintExtension::GetOrCreateExtension(UBlueprint* Blueprint)
 {
@@ -21,6 +24,13 @@ UMDStyleSetBlueprintExtension* UMDStyleSetBlueprintExtension::GetOrCreateExtensi
 
 		BPExtension = NewObject<UMDStyleSetBlueprintExtension>(Blueprint, NAME_None, RF_Transactional);
 		Blueprint->AddExtension(BPExtension);
+
+		// Widget blueprints also bake their bindings into the generated class so they can be re-applied at runtime
+		if (UWidgetBlueprint* WidgetBP = Cast<UWidgetBlueprint>(Blueprint))
+		{
+			UWidgetBlueprintExtension::RequestExtension<UMDStyleSetWidgetBlueprintExtension>(WidgetBP);
+		}
+
 		return BPExtension;
 	}
 
@@ -65,43 +75,137 @@ void UMDStyleSetBlueprintExtension::AddBinding(FMDStyleSetPropertyBinding&& Bind
 	if (IsValid(Binding.Value.StyleSet))
 	{
 		Modify();
-		Bindings.RemoveAll([&Binding](const FMDStyleSetPropertyBinding& B)
-			{
-				return B.TargetProperty == Binding.TargetProperty;
-			});
-		const int32 BindingIndex = Bindings.Emplace(MoveTemp(Binding));
+
+		int32 BindingIdx = FindBindingIndex(Binding.TargetProperty);
+		if (BindingIdx != INDEX_NONE)
+		{
+			Bindings[BindingIdx] = MoveTemp(Binding);
+		}
+		else
+		{
+			BindingIdx = Bindings.Emplace(MoveTemp(Binding));
+			BindingIndex.Add(GetPathHash(Bindings[BindingIdx].TargetProperty), BindingIdx);
+		}
 
 		FBlueprintEditorUtils::MarkBlueprintAsModified(GetTypedOuter<UBlueprint>());
 
-		ExecuteBindingOnCDO(Bindings[BindingIndex]);
+		ExecuteBindingOnCDO(Bindings[BindingIdx]);
 	}
 }
 
 const FMDStyleSetPropertyBinding* UMDStyleSetBlueprintExtension::FindBindingForProperty(const FPropertyBindingPath& PropertyPath) const
 {
+	const int32 BindingIdx = FindBindingIndex(PropertyPath);
+	return Bindings.IsValidIndex(BindingIdx) ? &Bindings[BindingIdx] : nullptr;
+}
+
+bool UMDStyleSetBlueprintExtension::RemoveBindingForProperty(const FPropertyBindingPath& PropertyPath)
+{
+	const int32 BindingIdx = FindBindingIndex(PropertyPath);
+	if (BindingIdx == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Modify();
+
+	// Keep the order of the remaining bindings since overlapping bindings are applied in order
+	Bindings.RemoveAt(BindingIdx);
+	RebuildBindingIndex();
+	return true;
+}
+
+void UMDStyleSetBlueprintExtension::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildBindingIndex();
+}
+
+void UMDStyleSetBlueprintExtension::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	RebuildBindingIndex();
+}
+
+void UMDStyleSetBlueprintExtension::RebuildBindingIndex() const
+{
+	BindingIndex.Reset();
+	BindingIndex.Reserve(Bindings.Num());
+
+	for (int32 i = 0; i < Bindings.Num(); ++i)
+	{
+		BindingIndex.Add(GetPathHash(Bindings[i].TargetProperty), i);
+	}
+}
+
+FString UMDStyleSetBlueprintExtension::CalculateContentHash() const
+{
+	// Bump when the way bindings are baked changes, so blueprints baked by an older version are re-baked
+	constexpr uint32 BakeVersion = 1;
+
+	FBlake3 Hasher;
+	Hasher.Update(&BakeVersion, sizeof(BakeVersion));
+
+	auto UpdateString = [&Hasher](const FString& String)
+	{
+		const FTCHARToUTF8 Utf8String(*String);
+		Hasher.Update(Utf8String.Get(), Utf8String.Length() + 1);
+	};
+
+	// The properties the bindings resolve to depend on the parent class
+	const UBlueprint* Blueprint = GetTypedOuter<UBlueprint>();
+	UpdateString(GetPathNameSafe(Blueprint != nullptr ? Blueprint->ParentClass.Get() : nullptr));
+
+	TSet<const UMDStyleSet*> HashedStyleSets;
 	for (const FMDStyleSetPropertyBinding& Binding : Bindings)
 	{
-		if (Binding.TargetProperty == PropertyPath)
+		UpdateString(Binding.TargetProperty.ToString());
+		UpdateString(GetPathNameSafe(Binding.Value.StyleSet));
+		UpdateString(Binding.Value.StyleValueTag.ToString());
+
+		bool bIsAlreadyHashed = false;
+		HashedStyleSets.Add(Binding.Value.StyleSet, &bIsAlreadyHashed);
+		if (!bIsAlreadyHashed && IsValid(Binding.Value.StyleSet))
 		{
-			return &Binding;
+			const FBlake3Hash StyleSetHash = Binding.Value.StyleSet->GetContentHash();
+			Hasher.Update(StyleSetHash.GetBytes(), sizeof(FBlake3Hash::ByteArray));
 		}
 	}
 
-	return nullptr;
+	return LexToString(Hasher.Finalize());
 }
 
-bool UMDStyleSetBlueprintExtension::RemoveBindingForProperty(const FPropertyBindingPath& PropertyPath)
+uint32 UMDStyleSetBlueprintExtension::GetPathHash(const FPropertyBindingPath& PropertyPath)
 {
-	for (auto It = Bindings.CreateIterator(); It; ++It)
+	// Only the segments are hashed, candidates are compared with the full path
+	uint32 Hash = 0;
+	for (const FPropertyBindingPathSegment& Segment : PropertyPath.GetSegments())
+	{
+		Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Segment.GetName()), GetTypeHash(Segment.GetArrayIndex())));
+	}
+
+	return Hash;
+}
+
+int32 UMDStyleSetBlueprintExtension::FindBindingIndex(const FPropertyBindingPath& PropertyPath) const
+{
+	// Bindings can be modified directly since it's a public property, rebuild if the index is obviously stale
+	if (BindingIndex.Num() != Bindings.Num())
+	{
+		RebuildBindingIndex();
+	}
+
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	BindingIndex.MultiFind(GetPathHash(PropertyPath), Candidates);
+	for (const int32 Candidate : Candidates)
 	{
-		const FMDStyleSetPropertyBinding& Binding = *It;
-		if (Binding.TargetProperty == PropertyPath)
+		if (Bindings.IsValidIndex(Candidate) && Bindings[Candidate].TargetProperty == PropertyPath)
 		{
-			Modify();
-			It.RemoveCurrent();
-			return true;
+			return Candidate;
 		}
 	}
 
-	return false;
+	return INDEX_NONE;
 }
@@ -0,0 +1,55 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Extensions/MDStyleSetWidgetBlueprintExtension.h"
+
+#include "Extensions/MDStyleSetBlueprintExtension.h"
+#include "Extensions/MDStyleSetWidgetClassExtension.h"
+#include "WidgetBlueprintCompiler.h"
+
+void UMDStyleSetWidgetBlueprintExtension::HandleBeginCompilation(FWidgetBlueprintCompilerContext& InCreationContext)
+{
+	Super::HandleBeginCompilation(InCreationContext);
+
+	CompilerContext = &InCreationContext;
+}
+
+void UMDStyleSetWidgetBlueprintExtension::HandleFinishCompilingClass(UWidgetBlueprintGeneratedClass* Class)
+{
+	Super::HandleFinishCompilingClass(Class);
+
+	if (CompilerContext == nullptr || !CompilerContext->bIsFullCompile)
+	{
+		return;
+	}
+
+	const UMDStyleSetBlueprintExtension* BPExtension = UMDStyleSetBlueprintExtension::GetExtension(GetWidgetBlueprint());
+	if (!IsValid(BPExtension))
+	{
+		return;
+	}
+
+	TArray<FMDStyleSetPropertyBinding> Bindings;
+	Bindings.Reserve(BPExtension->Bindings.Num());
+	for (const FMDStyleSetPropertyBinding& Binding : BPExtension->Bindings)
+	{
+		if (IsValid(Binding.Value.StyleSet))
+		{
+			Bindings.Add(Binding);
+		}
+	}
+
+	if (!Bindings.IsEmpty())
+	{
+		UMDStyleSetWidgetClassExtension* ClassExtension = NewObject<UMDStyleSetWidgetClassExtension>(Class);
+		ClassExtension->SetBindings(MoveTemp(Bindings));
+		CompilerContext->AddExtension(Class, ClassExtension);
+	}
+}
+
+void UMDStyleSetWidgetBlueprintExtension::HandleEndCompilation()
+{
+	CompilerContext = nullptr;
+
+	Super::HandleEndCompilation();
+}
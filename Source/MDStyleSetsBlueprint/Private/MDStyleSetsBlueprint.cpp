@@ -4,6 +4,7 @@
 
 #include "BlueprintCompilationManager.h"
 #include "Extensions/MDStyleSetBlueprintCompiler.h"
+#include "Util/MDStyleSetBindingIndex.h"
 
 #define LOCTEXT_NAMESPACE "FMDStyleSetsBlueprintModule"
 
@@ -12,10 +13,13 @@ void FMDStyleSetsBlueprintModule::StartupModule()
 	UMDStyleSetBlueprintCompiler* Compiler = NewObject<UMDStyleSetBlueprintCompiler>();
 	Compiler->BindPreCompile();
 	FBlueprintCompilationManager::RegisterCompilerExtension(UBlueprint::StaticClass(), Compiler);
+
+	FMDStyleSetBindingIndex::Register();
 }
 
 void FMDStyleSetsBlueprintModule::ShutdownModule()
 {
+	FMDStyleSetBindingIndex::Unregister();
 }
 
 #undef LOCTEXT_NAMESPACE
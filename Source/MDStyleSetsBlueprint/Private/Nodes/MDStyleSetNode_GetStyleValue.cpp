@@ -8,9 +8,14 @@
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
 #include "EdGraphSchema_K2.h"
+#include "K2Node_Knot.h"
+#include "K2Node_TemporaryVariable.h"
+#include "KismetCompiler.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "MDStyleSetFunctionLibrary.h"
 #include "MDStyleSet.h"
+#include "Util/MDStyleSetBlueprintPreloader.h"
+#include "Util/MDStyleSetTypes.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -187,6 +192,18 @@ void UMDStyleSetNode_GetStyleValue::ValidateNodeDuringCompilation(FCompilerResul
 #endif
 }
 
+void UMDStyleSetNode_GetStyleValue::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	if (bFoldConstantValue)
+	{
+		FoldConstantValue(CompilerContext);
+	}
+
+	ExpandCachedLookup(CompilerContext, SourceGraph);
+}
+
 UObject* UMDStyleSetNode_GetStyleValue::GetJumpTargetForDoubleClick() const
 {
 	return BoundStyleSet;
@@ -212,10 +229,40 @@ void UMDStyleSetNode_GetStyleValue::JumpToDefinition() const
 
 void UMDStyleSetNode_GetStyleValue::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
 {
-	auto CustomizeNodeLambda = [](UEdGraphNode* NewNode, bool bIsTemplateNode, TWeakObjectPtr<UMDStyleSet> InStyleSet)
+	auto CustomizeNodeLambda = [](UEdGraphNode* NewNode, bool bIsTemplateNode, FSoftObjectPath StyleSetPath, TOptional<FEdGraphPinType> StyleType)
 	{
 		UMDStyleSetNode_GetStyleValue* InputNode = CastChecked<UMDStyleSetNode_GetStyleValue>(NewNode);
-		InputNode->BoundStyleSet = InStyleSet.Get();
+		// Template nodes are created to build the action menu, only load the Style Set once the node is actually placed
+		InputNode->BoundStyleSet = Cast<UMDStyleSet>(bIsTemplateNode ? StyleSetPath.ResolveObject() : StyleSetPath.TryLoad());
+
+		// The menu filters actions by the template's pin types, so they need the style type even if the Style Set isn't loaded
+		if (bIsTemplateNode && !IsValid(InputNode->BoundStyleSet))
+		{
+			InputNode->TemplateStyleType = MoveTemp(StyleType);
+		}
+	};
+
+	// The menu entry is built from the asset registry tags so the Style Set doesn't need to be loaded
+	auto CreateNodeSpawner = [this, &CustomizeNodeLambda](const FAssetData& StyleAsset)
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		const FText StyleName = UMDStyleSet::GetDisplayNameFromAssetData(StyleAsset);
+		NodeSpawner->DefaultMenuSignature.MenuName = FText::Format(INVTEXT("Get '{0}' Style Value"), StyleName);
+		NodeSpawner->DefaultMenuSignature.Tooltip = FText::Format(INVTEXT("Style Set: {0} - {1}\r{2} styles"), StyleName, FText::FromName(StyleAsset.AssetName), UMDStyleSet::GetEntryCountFromAssetData(StyleAsset));
+		NodeSpawner->DefaultMenuSignature.Keywords = FText::FromString(UMDStyleSet::GetStyleSetTagFromAssetData(StyleAsset).ToString());
+
+		TOptional<FEdGraphPinType> StyleType;
+		FEdGraphPinType AssetStyleType;
+		if (UMDStyleSet::GetStyleTypeFromAssetData(StyleAsset, AssetStyleType))
+		{
+			NodeSpawner->DefaultMenuSignature.IconTint = GetDefault<UEdGraphSchema_K2>()->GetPinTypeColor(AssetStyleType);
+			StyleType = MoveTemp(AssetStyleType);
+		}
+
+		NodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateStatic(CustomizeNodeLambda, StyleAsset.GetSoftObjectPath(), MoveTemp(StyleType));
+		return NodeSpawner;
 	};
 
 	if (ActionRegistrar.IsOpenForRegistration(GetClass()))
@@ -236,26 +283,15 @@ void UMDStyleSetNode_GetStyleValue::GetMenuActions(FBlueprintActionDatabaseRegis
 		AssetRegistry.GetAssetsByClass(UMDStyleSet::StaticClass()->GetClassPathName(), StyleAssets, true);
 		for (const FAssetData& StyleAsset : StyleAssets)
 		{
-			UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
-			check(NodeSpawner != nullptr);
-
 			if (FPackageName::GetPackageMountPoint(StyleAsset.PackageName.ToString()) != NAME_None)
 			{
-				if (UMDStyleSet* StyleSet = Cast<UMDStyleSet>(StyleAsset.GetAsset()))
-				{
-					NodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateStatic(CustomizeNodeLambda, MakeWeakObjectPtr(StyleSet));
-					ActionRegistrar.AddBlueprintAction(StyleSet, NodeSpawner);
-				}
+				ActionRegistrar.AddBlueprintAction(StyleAsset, CreateNodeSpawner(StyleAsset));
 			}
 		}
 	}
 	else if (UMDStyleSet* StyleSet = const_cast<UMDStyleSet*>(Cast<UMDStyleSet>(ActionRegistrar.GetActionKeyFilter())))
 	{
-		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
-		check(NodeSpawner != nullptr);
-
-		NodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateStatic(CustomizeNodeLambda, MakeWeakObjectPtr(StyleSet));
-		ActionRegistrar.AddBlueprintAction(StyleSet, NodeSpawner);
+		ActionRegistrar.AddBlueprintAction(StyleSet, CreateNodeSpawner(FAssetData(StyleSet)));
 	}
 }
 
@@ -277,15 +313,7 @@ void UMDStyleSetNode_GetStyleValue::UpdatePinData()
 {
 	if (IsValid(BoundStyleSet))
 	{
-		if (BoundStyleSet->HasAnyFlags(RF_NeedLoad))
-		{
-			BoundStyleSet->GetLinker()->Preload(BoundStyleSet);
-		}
-
-		if (BoundStyleSet->HasAnyFlags(RF_NeedPostLoad))
-		{
-			BoundStyleSet->ConditionalPostLoad();
-		}
+		FMDStyleSetBlueprintPreloader::PreloadStyleSet(BoundStyleSet);
 
 		if (UEdGraphPin* StyleSetPin = FindPin(TEXT("StyleSet")))
 		{
@@ -309,6 +337,116 @@ void UMDStyleSetNode_GetStyleValue::UpdatePinData()
 			}
 		}
 	}
+	else if (TemplateStyleType.IsSet())
+	{
+		// Template nodes aren't in a blueprint, their pins only need to match the node that would be placed
+		if (UEdGraphPin* StyleSetPin = FindPin(TEXT("StyleSet")))
+		{
+			StyleSetPin->bHidden = true;
+		}
+
+		if (UEdGraphPin* ValuePin = FindPin(TEXT("OutValue")))
+		{
+			ValuePin->PinType = TemplateStyleType.GetValue();
+		}
+	}
+}
+
+void UMDStyleSetNode_GetStyleValue::FoldConstantValue(FKismetCompilerContext& CompilerContext)
+{
+	UEdGraphPin* StyleTagPin = FindPin(TEXT("StyleTag"));
+	UEdGraphPin* ValuePin = FindPin(TEXT("OutValue"));
+	if (!IsValid(BoundStyleSet) || StyleTagPin == nullptr || ValuePin == nullptr || !StyleTagPin->LinkedTo.IsEmpty() || ValuePin->PinType.IsContainer())
+	{
+		return;
+	}
+
+	const FMDStyleValueView Value = BoundStyleSet->GetStyleValueView(GetStyleTag());
+	if (!Value.IsValid()
+		|| Value.GetValueType() != UMDStyleSet::GetValueTypeFromPinType(ValuePin->PinType)
+		|| Value.GetValueTypeObject() != ValuePin->PinType.PinSubCategoryObject.Get())
+	{
+		return;
+	}
+
+	FString ValueString;
+	if (!FBlueprintEditorUtils::PropertyValueToString_Direct(Value.GetProperty(), Value.GetMemory(), ValueString, this))
+	{
+		return;
+	}
+
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+	for (UEdGraphPin* LinkedPin : TArray<UEdGraphPin*>(ValuePin->LinkedTo))
+	{
+		// Reroute nodes and reference pins don't read their default value
+		if (LinkedPin == nullptr || LinkedPin->PinType.bIsReference || LinkedPin->bDefaultValueIsIgnored || LinkedPin->GetOwningNode()->IsA<UK2Node_Knot>()
+			|| LinkedPin->PinType != ValuePin->PinType)
+		{
+			continue;
+		}
+
+		const FString PreviousDefaultValue = LinkedPin->DefaultValue;
+		UObject* PreviousDefaultObject = LinkedPin->DefaultObject;
+		const FText PreviousDefaultTextValue = LinkedPin->DefaultTextValue;
+
+		Schema->TrySetDefaultValue(*LinkedPin, ValueString, false);
+		if (Schema->IsPinDefaultValid(LinkedPin, LinkedPin->DefaultValue, LinkedPin->DefaultObject, LinkedPin->DefaultTextValue).IsEmpty())
+		{
+			ValuePin->BreakLinkTo(LinkedPin);
+		}
+		else
+		{
+			LinkedPin->DefaultValue = PreviousDefaultValue;
+			LinkedPin->DefaultObject = PreviousDefaultObject;
+			LinkedPin->DefaultTextValue = PreviousDefaultTextValue;
+		}
+	}
+}
+
+void UMDStyleSetNode_GetStyleValue::ExpandCachedLookup(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	// Constant tags are looked up once per call anyway and function libraries have no instance to keep the cache in
+	UEdGraphPin* StyleSetPin = FindPin(TEXT("StyleSet"));
+	UEdGraphPin* StyleTagPin = FindPin(TEXT("StyleTag"));
+	UEdGraphPin* ValuePin = FindPin(TEXT("OutValue"));
+	const EBlueprintType BlueprintType = CompilerContext.Blueprint->BlueprintType;
+	if (StyleSetPin == nullptr || StyleTagPin == nullptr || ValuePin == nullptr || StyleTagPin->LinkedTo.IsEmpty() || ValuePin->LinkedTo.IsEmpty()
+		|| BlueprintType == BPTYPE_FunctionLibrary || BlueprintType == BPTYPE_MacroLibrary || BlueprintType == BPTYPE_Interface)
+	{
+		return;
+	}
+
+	UK2Node_CallFunction* CallNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UMDStyleSetFunctionLibrary, GetStyleValueCached), UMDStyleSetFunctionLibrary::StaticClass());
+	CallNode->AllocateDefaultPins();
+
+	UEdGraphPin* CallValuePin = CallNode->FindPinChecked(TEXT("OutValue"));
+	CallValuePin->PinType = ValuePin->PinType;
+
+	// The cache is a variable of the blueprint instance, so it's gone with the instance when the blueprint is recompiled or unloaded
+	UK2Node_TemporaryVariable* CacheVariable = CompilerContext.SpawnInternalVariable(this, UEdGraphSchema_K2::PC_Struct, NAME_None, FMDStyleSetValueCache::StaticStruct());
+	CompilerContext.GetSchema()->TryCreateConnection(CacheVariable->GetVariablePin(), CallNode->FindPinChecked(TEXT("Cache")));
+
+	CompilerContext.MovePinLinksToIntermediate(*StyleSetPin, *CallNode->FindPinChecked(TEXT("StyleSet")));
+	CompilerContext.MovePinLinksToIntermediate(*StyleTagPin, *CallNode->FindPinChecked(TEXT("StyleTag")));
+	CompilerContext.MovePinLinksToIntermediate(*ValuePin, *CallValuePin);
+
+	BreakAllNodeLinks();
+}
+
+bool UMDStyleSetNode_GetStyleValue::IsBoundToStyleSet(const UObject* StyleSet) const
+{
+	// Values can come from the base Style Sets, the depth limit guards against cycles
+	int32 Depth = 0;
+	for (const UMDStyleSet* TestStyleSet = BoundStyleSet; IsValid(TestStyleSet) && Depth < 32; TestStyleSet = TestStyleSet->BaseStyleSet, ++Depth)
+	{
+		if (TestStyleSet == StyleSet)
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void UMDStyleSetNode_GetStyleValue::UpdatePreviewWidget()
@@ -326,4 +464,13 @@ void UMDStyleSetNode_GetStyleValue::OnPropertyValueChanged(UObject* Object, FPro
 	{
 		GetSchema()->ReconstructNode(*this);
 	}
+	else if (bFoldConstantValue && IsBoundToStyleSet(Object))
+	{
+		// The folded value is baked into the compiled blueprint, it needs to be recompiled to pick up the new value
+		UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(this);
+		if (IsValid(Blueprint) && Blueprint->Status != BS_Dirty)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		}
+	}
 }
@@ -0,0 +1,530 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Util/MDStyleSetBindingIndex.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
+#include "Blueprint/WidgetTree.h"
+#include "Containers/Ticker.h"
+#include "Engine/Blueprint.h"
+#include "Extensions/MDStyleSetBlueprintCompiler.h"
+#include "Extensions/MDStyleSetBlueprintExtension.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "MDStyleSet.h"
+#include "Nodes/MDStyleSetNode_GetStyleValue.h"
+#include "UObject/AssetRegistryTagsContext.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "Util/MDStyleSetTypes.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMDStyleSetBindingIndex, Log, All);
+
+namespace MDSSBI
+{
+	FDelegateHandle ExtraObjectTagsHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+
+	const TCHAR* EntryDelimiter = TEXT(";");
+	const TCHAR* FieldDelimiter = TEXT("|");
+	// Stands in for a Style Set or tag that's only known at runtime
+	const TCHAR* UnknownValue = TEXT("*");
+	// Third field of the entries that only read the value, e.g. Get Style Value nodes, bindings only have the Style Set and tag
+	const TCHAR* ReadOnlyField = TEXT("Read");
+
+	struct FEntry
+	{
+		FString StyleSetPath;
+		FString TagString;
+		bool bIsBinding = false;
+	};
+
+	// StyleSetPath|Tag for bindings, StyleSetPath|Tag|Read for other references
+	TArray<FEntry> ParseEntries(const FAssetData& BlueprintAsset)
+	{
+		TArray<FEntry> Result;
+
+		FString EntriesString;
+		if (!BlueprintAsset.GetTagValue(FMDStyleSetBindingIndex::BindingsAssetTagName, EntriesString))
+		{
+			return Result;
+		}
+
+		TArray<FString> Entries;
+		TArray<FString> Fields;
+		EntriesString.ParseIntoArray(Entries, EntryDelimiter, true);
+		for (const FString& Entry : Entries)
+		{
+			Fields.Reset();
+			Entry.ParseIntoArray(Fields, FieldDelimiter, false);
+			if (Fields.Num() >= 2)
+			{
+				Result.Add({ Fields[0], Fields[1], Fields.Num() == 2 });
+			}
+		}
+
+		return Result;
+	}
+
+	struct FReferences
+	{
+		TSet<FGameplayTag> Tags;
+		// Style Sets read with a tag that's only known at runtime
+		TSet<FString> DynamicStyleSets;
+		// A tag only known at runtime is read from a Style Set only known at runtime
+		bool bHasUnknownLookups = false;
+	};
+
+	// Gathered from every blueprint's tag once, reset when a blueprint changes
+	TOptional<FReferences> CachedReferences;
+
+	const FReferences& GetReferences()
+	{
+		if (CachedReferences.IsSet())
+		{
+			return CachedReferences.GetValue();
+		}
+
+		FReferences& References = CachedReferences.Emplace();
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.WaitForCompletion();
+
+		FARFilter Filter;
+		Filter.TagsAndValues.Add(FMDStyleSetBindingIndex::BindingsAssetTagName, TOptional<FString>());
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssets(Filter, Assets);
+
+		for (const FAssetData& Asset : Assets)
+		{
+			for (const FEntry& Entry : ParseEntries(Asset))
+			{
+				if (Entry.TagString != UnknownValue)
+				{
+					const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(Entry.TagString), false);
+					if (Tag.IsValid())
+					{
+						References.Tags.Add(Tag);
+					}
+				}
+				else if (Entry.StyleSetPath != UnknownValue)
+				{
+					References.DynamicStyleSets.Add(Entry.StyleSetPath);
+				}
+				else
+				{
+					References.bHasUnknownLookups = true;
+				}
+			}
+		}
+
+		return References;
+	}
+
+	// Visits the assets referencing StyleSet or a Style Set that inherits from it, Style Sets are visited before their own referencers.
+	// Stops and returns false as soon as Visitor returns false.
+	bool VisitReferencers(const UMDStyleSet* StyleSet, TFunctionRef<bool(const FAssetData& ReferencerAsset, bool bIsStyleSet)> Visitor)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		TSet<FName> VisitedPackages;
+		TArray<FName> PackagesToVisit = { StyleSet->GetPackage()->GetFName() };
+		while (!PackagesToVisit.IsEmpty())
+		{
+			const FName PackageName = PackagesToVisit.Pop();
+			if (VisitedPackages.Contains(PackageName))
+			{
+				continue;
+			}
+
+			VisitedPackages.Add(PackageName);
+
+			TArray<FName> Referencers;
+			AssetRegistry.GetReferencers(PackageName, Referencers);
+			for (const FName& Referencer : Referencers)
+			{
+				TArray<FAssetData> ReferencerAssets;
+				AssetRegistry.GetAssetsByPackageName(Referencer, ReferencerAssets);
+				for (const FAssetData& ReferencerAsset : ReferencerAssets)
+				{
+					const bool bIsStyleSet = ReferencerAsset.IsInstanceOf(UMDStyleSet::StaticClass());
+					if (!Visitor(ReferencerAsset, bIsStyleSet))
+					{
+						return false;
+					}
+
+					if (bIsStyleSet)
+					{
+						PackagesToVisit.Add(Referencer);
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Bindings to a tag without an entry can read the entry of one of its parents when the Style Set falls back to parent tags
+	bool ContainsTagOrParent(const TSet<FGameplayTag>& Tags, FGameplayTag Tag)
+	{
+		for (; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+		{
+			if (Tags.Contains(Tag))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Bindings to widgets in the tree start with the widget's name, the rest of the path is relative to the widget
+	FMDStyleSetBindingTarget ResolveWidgetTreeBindingTarget(UWidgetTree* WidgetTree, const FMDStyleSetPropertyBinding& Binding)
+	{
+		FMDStyleSetBindingTarget Target;
+		if (Binding.TargetProperty.NumSegments() < 2)
+		{
+			return Target;
+		}
+
+		UWidget* Widget = WidgetTree->FindWidget(Binding.TargetProperty.GetSegment(0).GetName());
+		if (Widget == nullptr)
+		{
+			return Target;
+		}
+
+		FPropertyBindingPath TrimmedPath;
+		for (int32 i = 1; i < Binding.TargetProperty.NumSegments(); ++i)
+		{
+			TrimmedPath.AddPathSegment(Binding.TargetProperty.GetSegment(i));
+		}
+
+		TArray<FPropertyBindingPathIndirection> Indirections;
+		if (TrimmedPath.ResolveIndirectionsWithValue(Widget, Indirections, nullptr, true) && !Indirections.IsEmpty() && Indirections.Last().GetContainerAddress() != nullptr)
+		{
+			Target.Property = Indirections.Last().GetProperty();
+			Target.Address = Indirections.Last().GetMutablePropertyAddress();
+		}
+
+		return Target;
+	}
+}
+
+const FName FMDStyleSetBindingIndex::BindingsAssetTagName = TEXT("MDStyleSetBindings");
+
+void FMDStyleSetBindingIndex::Register()
+{
+	MDSSBI::ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&FMDStyleSetBindingIndex::OnGetExtraObjectTags);
+	MDSSBI::PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddStatic(&FMDStyleSetBindingIndex::OnPackageSaved);
+	UMDStyleSet::GatherReferencedTagsForCook.BindStatic(&FMDStyleSetBindingIndex::GatherReferencedTags);
+
+	// Blueprints aren't edited while cooking, so the references gathered for the first Style Set are kept for the rest of the cook
+	if (!IsRunningCookCommandlet())
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		MDSSBI::AssetAddedHandle = AssetRegistry.OnAssetAdded().AddStatic(&FMDStyleSetBindingIndex::OnAssetChanged);
+		MDSSBI::AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddStatic(&FMDStyleSetBindingIndex::OnAssetChanged);
+		MDSSBI::AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddStatic(&FMDStyleSetBindingIndex::OnAssetChanged);
+	}
+}
+
+void FMDStyleSetBindingIndex::Unregister()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(MDSSBI::ExtraObjectTagsHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(MDSSBI::PackageSavedHandle);
+	UMDStyleSet::GatherReferencedTagsForCook.Unbind();
+	MDSSBI::ExtraObjectTagsHandle.Reset();
+	MDSSBI::PackageSavedHandle.Reset();
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(MDSSBI::AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(MDSSBI::AssetRemovedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(MDSSBI::AssetUpdatedHandle);
+	}
+
+	MDSSBI::AssetAddedHandle.Reset();
+	MDSSBI::AssetRemovedHandle.Reset();
+	MDSSBI::AssetUpdatedHandle.Reset();
+	MDSSBI::CachedReferences.Reset();
+}
+
+TArray<FAssetData> FMDStyleSetBindingIndex::FindBlueprintsUsingStyleValues(const UMDStyleSet* StyleSet, const TSet<FGameplayTag>& Tags)
+{
+	TArray<FAssetData> Result;
+	if (!IsValid(StyleSet) || Tags.IsEmpty())
+	{
+		return Result;
+	}
+
+	// Style Sets inheriting from StyleSet reference it, so walk the referencers to find them and the blueprints binding any of them
+	TSet<FString> StyleSetPaths = { FSoftObjectPath(StyleSet).ToString() };
+	TArray<FAssetData> CandidateBlueprints;
+	MDSSBI::VisitReferencers(StyleSet, [&StyleSetPaths, &CandidateBlueprints](const FAssetData& ReferencerAsset, bool bIsStyleSet)
+	{
+		if (bIsStyleSet)
+		{
+			StyleSetPaths.Add(ReferencerAsset.GetSoftObjectPath().ToString());
+		}
+		else if (ReferencerAsset.FindTag(BindingsAssetTagName))
+		{
+			CandidateBlueprints.AddUnique(ReferencerAsset);
+		}
+
+		return true;
+	});
+
+	for (const FAssetData& CandidateBlueprint : CandidateBlueprints)
+	{
+		for (const MDSSBI::FEntry& Entry : MDSSBI::ParseEntries(CandidateBlueprint))
+		{
+			if (Entry.bIsBinding
+				&& StyleSetPaths.Contains(Entry.StyleSetPath)
+				&& MDSSBI::ContainsTagOrParent(Tags, FGameplayTag::RequestGameplayTag(FName(Entry.TagString), false)))
+			{
+				Result.Add(CandidateBlueprint);
+				break;
+			}
+		}
+	}
+
+	return Result;
+}
+
+bool FMDStyleSetBindingIndex::HasBindings(const FAssetData& BlueprintAsset)
+{
+	return MDSSBI::ParseEntries(BlueprintAsset).ContainsByPredicate([](const MDSSBI::FEntry& Entry) { return Entry.bIsBinding; });
+}
+
+bool FMDStyleSetBindingIndex::GatherReferencedTags(const UMDStyleSet* StyleSet, TSet<FGameplayTag>& OutTags)
+{
+	if (!IsValid(StyleSet))
+	{
+		return false;
+	}
+
+	const MDSSBI::FReferences& References = MDSSBI::GetReferences();
+	if (References.bHasUnknownLookups)
+	{
+		UE_LOG(LogMDStyleSetBindingIndex, Display, TEXT("Not stripping [%s], a blueprint reads a style tag only known at runtime from a Style Set only known at runtime"), *GetPathNameSafe(StyleSet));
+		return false;
+	}
+
+	if (References.DynamicStyleSets.Contains(FSoftObjectPath(StyleSet).ToString()))
+	{
+		UE_LOG(LogMDStyleSetBindingIndex, Display, TEXT("Not stripping [%s], a blueprint reads a style tag from it that's only known at runtime"), *GetPathNameSafe(StyleSet));
+		return false;
+	}
+
+	// Style Sets inheriting from StyleSet read its entries, so their referencers have to be known too
+	const bool bAreReferencesKnown = MDSSBI::VisitReferencers(StyleSet, [StyleSet, &References](const FAssetData& ReferencerAsset, bool bIsStyleSet)
+	{
+		if (bIsStyleSet)
+		{
+			if (References.DynamicStyleSets.Contains(ReferencerAsset.GetSoftObjectPath().ToString()))
+			{
+				UE_LOG(LogMDStyleSetBindingIndex, Display, TEXT("Not stripping [%s], a blueprint reads a style tag only known at runtime from [%s] which inherits from it"), *GetPathNameSafe(StyleSet), *ReferencerAsset.GetObjectPathString());
+				return false;
+			}
+		}
+		else if (!ReferencerAsset.FindTag(BindingsAssetTagName))
+		{
+			UE_LOG(LogMDStyleSetBindingIndex, Display, TEXT("Not stripping [%s], the tags read by [%s] aren't known, resave it if it's a blueprint"), *GetPathNameSafe(StyleSet), *ReferencerAsset.GetObjectPathString());
+			return false;
+		}
+
+		return true;
+	});
+
+	if (!bAreReferencesKnown)
+	{
+		return false;
+	}
+
+	OutTags.Append(References.Tags);
+	return true;
+}
+
+bool FMDStyleSetBindingIndex::RebakeBlueprint(UBlueprint* Blueprint, TArray<EMDStyleSetBindingExecutionResult>* OutResults)
+{
+	UMDStyleSetBlueprintExtension* BPExtension = UMDStyleSetBlueprintExtension::GetExtension(Blueprint);
+	if (!IsValid(BPExtension) || BPExtension->Bindings.IsEmpty() || !IsValid(Blueprint->GeneratedClass))
+	{
+		return false;
+	}
+
+	constexpr bool bShouldRemoveFailedBindings = false;
+	UMDStyleSetBlueprintCompiler::ExecuteBindingsOnBlueprint(Blueprint, BPExtension, bShouldRemoveFailedBindings, OutResults);
+
+	// Widgets are instanced from the generated class's widget tree, which is only copied from the blueprint's widgets when compiling
+	if (const UWidgetBlueprintGeneratedClass* WidgetClass = Cast<UWidgetBlueprintGeneratedClass>(Blueprint->GeneratedClass))
+	{
+		if (UWidgetTree* WidgetTree = WidgetClass->GetWidgetTreeArchetype())
+		{
+			for (const FMDStyleSetPropertyBinding& Binding : BPExtension->Bindings)
+			{
+				const FMDStyleSetBindingTarget Target = MDSSBI::ResolveWidgetTreeBindingTarget(WidgetTree, Binding);
+				if (Target.Property != nullptr && IsValid(Binding.Value.StyleSet))
+				{
+					Binding.Value.StyleSet->TrySetPropertyValue(Binding.Value.StyleValueTag, Target.Property, Target.Address);
+				}
+			}
+		}
+	}
+
+	BPExtension->BakedContentHash = BPExtension->CalculateContentHash();
+	Blueprint->MarkPackageDirty();
+	return true;
+}
+
+void FMDStyleSetBindingIndex::OnGetExtraObjectTags(FAssetRegistryTagsContext Context)
+{
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Context.GetObject());
+	if (!IsValid(Blueprint))
+	{
+		return;
+	}
+
+	// StyleSetPath|Tag;StyleSetPath|Tag|Read
+	TSet<FString> Entries;
+	auto AddEntry = [&Entries](const FString& StyleSetPath, const FString& TagString, bool bIsBinding)
+	{
+		if (bIsBinding)
+		{
+			Entries.Add(FString::Printf(TEXT("%s%s%s"), *StyleSetPath, MDSSBI::FieldDelimiter, *TagString));
+		}
+		else
+		{
+			Entries.Add(FString::Printf(TEXT("%s%s%s%s%s"), *StyleSetPath, MDSSBI::FieldDelimiter, *TagString, MDSSBI::FieldDelimiter, MDSSBI::ReadOnlyField));
+		}
+	};
+
+	if (const UMDStyleSetBlueprintExtension* BPExtension = UMDStyleSetBlueprintExtension::GetExtension(Blueprint))
+	{
+		for (const FMDStyleSetPropertyBinding& Binding : BPExtension->Bindings)
+		{
+			if (IsValid(Binding.Value.StyleSet))
+			{
+				AddEntry(FSoftObjectPath(Binding.Value.StyleSet).ToString(), Binding.Value.StyleValueTag.ToString(), true);
+			}
+		}
+	}
+
+	TArray<UMDStyleSetNode_GetStyleValue*> StyleNodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, StyleNodes);
+	for (const UMDStyleSetNode_GetStyleValue* StyleNode : StyleNodes)
+	{
+		const UObject* StyleSet = StyleNode->BoundStyleSet;
+		if (StyleSet == nullptr)
+		{
+			const UEdGraphPin* StyleSetPin = StyleNode->FindPin(TEXT("StyleSet"));
+			StyleSet = (StyleSetPin != nullptr && StyleSetPin->LinkedTo.IsEmpty()) ? StyleSetPin->DefaultObject.Get() : nullptr;
+		}
+
+		const UEdGraphPin* StyleTagPin = StyleNode->FindPin(TEXT("StyleTag"));
+		const bool bIsTagDynamic = StyleTagPin != nullptr && !StyleTagPin->LinkedTo.IsEmpty();
+		const FGameplayTag StyleTag = StyleNode->GetStyleTag();
+		if (bIsTagDynamic || StyleTag.IsValid())
+		{
+			AddEntry(StyleSet != nullptr ? FSoftObjectPath(StyleSet).ToString() : MDSSBI::UnknownValue, bIsTagDynamic ? MDSSBI::UnknownValue : StyleTag.ToString(), false);
+		}
+	}
+
+	// Only the blueprint's own variables are checked, references nested in containers or structs have to be kept with the Style Set's Cook Keep Tags
+	if (const UObject* CDO = IsValid(Blueprint->GeneratedClass) ? Blueprint->GeneratedClass->GetDefaultObject(false) : nullptr)
+	{
+		for (TFieldIterator<FStructProperty> It(Blueprint->GeneratedClass, EFieldIterationFlags::None); It; ++It)
+		{
+			if (It->Struct == FMDStyleSetValueReference::StaticStruct())
+			{
+				const FMDStyleSetValueReference* Reference = It->ContainerPtrToValuePtr<FMDStyleSetValueReference>(CDO);
+				if (IsValid(Reference->StyleSet) && Reference->StyleValueTag.IsValid())
+				{
+					AddEntry(FSoftObjectPath(Reference->StyleSet).ToString(), Reference->StyleValueTag.ToString(), false);
+				}
+			}
+			else if (It->Struct == FMDStyleSetSoftValueReference::StaticStruct())
+			{
+				const FMDStyleSetSoftValueReference* Reference = It->ContainerPtrToValuePtr<FMDStyleSetSoftValueReference>(CDO);
+				if (!Reference->StyleSet.IsNull() && Reference->StyleValueTag.IsValid())
+				{
+					AddEntry(Reference->StyleSet.ToSoftObjectPath().ToString(), Reference->StyleValueTag.ToString(), false);
+				}
+			}
+		}
+	}
+
+	if (!Entries.IsEmpty())
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(BindingsAssetTagName, FString::Join(Entries, MDSSBI::EntryDelimiter), UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+
+void FMDStyleSetBindingIndex::OnAssetChanged(const FAssetData& AssetData)
+{
+	// Only blueprints carry the references tag
+	if (AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+	{
+		MDSSBI::CachedReferences.Reset();
+	}
+}
+
+void FMDStyleSetBindingIndex::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	if (SaveContext.IsProceduralSave() || (SaveContext.GetSaveFlags() & SAVE_FromAutosave) != 0 || !IsValid(Package))
+	{
+		return;
+	}
+
+	UMDStyleSet* StyleSet = Cast<UMDStyleSet>(Package->FindAssetInPackage());
+	if (!IsValid(StyleSet))
+	{
+		return;
+	}
+
+	const TArray<FGameplayTag> ChangedTags = StyleSet->ConsumeChangedTags();
+	if (ChangedTags.IsEmpty())
+	{
+		return;
+	}
+
+	// Blueprints may need to be loaded, which isn't safe while still saving
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakStyleSet = MakeWeakObjectPtr(StyleSet), Tags = TSet<FGameplayTag>(ChangedTags)](float)
+	{
+		RebakeBlueprintsUsingStyleValues(WeakStyleSet.Get(), Tags);
+		return false;
+	}));
+}
+
+void FMDStyleSetBindingIndex::RebakeBlueprintsUsingStyleValues(const UMDStyleSet* StyleSet, const TSet<FGameplayTag>& Tags)
+{
+	if (!IsValid(StyleSet))
+	{
+		return;
+	}
+
+	int32 NumRebaked = 0;
+	for (const FAssetData& BlueprintAsset : FindBlueprintsUsingStyleValues(StyleSet, Tags))
+	{
+		if (RebakeBlueprint(Cast<UBlueprint>(BlueprintAsset.GetAsset())))
+		{
+			UE_LOG(LogMDStyleSetBindingIndex, Log, TEXT("Re-baked style bindings of [%s] after saving [%s]"), *BlueprintAsset.GetObjectPathString(), *GetPathNameSafe(StyleSet));
+			++NumRebaked;
+		}
+	}
+
+	if (NumRebaked > 0)
+	{
+		FNotificationInfo Info(FText::Format(INVTEXT("Re-baked the style bindings of {0} blueprints using '{1}', see the output log for the list"), NumRebaked, StyleSet->GetDisplayName()));
+		Info.ExpireDuration = 5.f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+	}
+}
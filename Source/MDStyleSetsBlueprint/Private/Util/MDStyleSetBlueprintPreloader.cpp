@@ -0,0 +1,68 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+
+#include "Util/MDStyleSetBlueprintPreloader.h"
+
+#include "Engine/Blueprint.h"
+#include "Extensions/MDStyleSetBlueprintExtension.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "MDStyleSet.h"
+#include "Nodes/MDStyleSetNode_GetStyleValue.h"
+
+void FMDStyleSetBlueprintPreloader::GatherStyleSets(const UBlueprint* Blueprint, TSet<UMDStyleSet*>& OutStyleSets)
+{
+	if (!IsValid(Blueprint))
+	{
+		return;
+	}
+
+	if (const UMDStyleSetBlueprintExtension* BPExtension = UMDStyleSetBlueprintExtension::GetExtension(Blueprint))
+	{
+		for (const FMDStyleSetPropertyBinding& Binding : BPExtension->Bindings)
+		{
+			if (IsValid(Binding.Value.StyleSet))
+			{
+				OutStyleSets.Add(Binding.Value.StyleSet);
+			}
+		}
+	}
+
+	TArray<UMDStyleSetNode_GetStyleValue*> StyleNodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, StyleNodes);
+	for (const UMDStyleSetNode_GetStyleValue* StyleNode : StyleNodes)
+	{
+		if (IsValid(StyleNode->BoundStyleSet))
+		{
+			OutStyleSets.Add(StyleNode->BoundStyleSet);
+		}
+	}
+}
+
+void FMDStyleSetBlueprintPreloader::PreloadStyleSets(const TSet<UMDStyleSet*>& StyleSets)
+{
+	for (UMDStyleSet* StyleSet : StyleSets)
+	{
+		PreloadStyleSet(StyleSet);
+	}
+}
+
+void FMDStyleSetBlueprintPreloader::PreloadStyleSet(UMDStyleSet* StyleSet)
+{
+	if (!IsValid(StyleSet))
+	{
+		return;
+	}
+
+	if (StyleSet->HasAnyFlags(RF_NeedLoad))
+	{
+		if (FLinkerLoad* Linker = StyleSet->GetLinker())
+		{
+			Linker->Preload(StyleSet);
+		}
+	}
+
+	if (StyleSet->HasAnyFlags(RF_NeedPostLoad))
+	{
+		StyleSet->ConditionalPostLoad();
+	}
+}
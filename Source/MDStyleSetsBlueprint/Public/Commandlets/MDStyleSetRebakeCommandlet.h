@@ -0,0 +1,28 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "MDStyleSetRebakeCommandlet.generated.h"
+
+/**
+ * Re-bakes the style bindings of every blueprint in the project without recompiling them, and saves the blueprints whose baked values changed.
+ * Writes a JSON report of the failed bindings and timings, returns 1 if any blueprint or binding failed.
+ *
+ * Usage: -run=MDStyleSetRebake [-Report=<Path>] [-BatchSize=<Count>] [-AllBlueprints] [-DryRun]
+ *   -Report: Where to write the report, defaults to Saved/MDStyleSets/RebakeReport.json
+ *   -BatchSize: How many blueprints are loaded at once before being re-baked, defaults to 32
+ *   -AllBlueprints: Scan every blueprint instead of only the ones with the bindings asset registry tag, for blueprints saved before the tag existed
+ *   -DryRun: Don't save the changed blueprints
+ */
+UCLASS()
+class MDSTYLESETSBLUEPRINT_API UMDStyleSetRebakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMDStyleSetRebakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
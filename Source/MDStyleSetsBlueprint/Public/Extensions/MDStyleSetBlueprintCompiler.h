@@ -4,18 +4,10 @@
 
 #include "BlueprintCompilerExtension.h"
 #include "PropertyBindingPath.h"
+#include "Util/MDStyleSetTypes.h"
 #include "MDStyleSetBlueprintCompiler.generated.h"
 
 class UMDStyleSetBlueprintExtension;
-struct FMDStyleSetPropertyBinding;
-
-enum class EMDStyleSetBindingExecutionResult : uint8
-{
-	Success,
-	StyleNotFound,
-	PropertyNotFound,
-	CouldNotSetValue
-};
 
 /**
  *
@@ -27,7 +19,11 @@ class MDSTYLESETSBLUEPRINT_API UMDStyleSetBlueprintCompiler : public UBlueprintC
 
 public:
 	static EMDStyleSetBindingExecutionResult ExecuteBindingOnBlueprint(UBlueprint* Blueprint, const FPropertyBindingDataView BaseValueView, const FMDStyleSetPropertyBinding& Binding);
-	static void ExecuteBindingsOnBlueprint(UBlueprint* Blueprint, UMDStyleSetBlueprintExtension* BPExtension, bool bShouldRemoveFailedBindings);
+	// OutResults is parallel to the bindings before any failed binding is removed
+	static void ExecuteBindingsOnBlueprint(UBlueprint* Blueprint, UMDStyleSetBlueprintExtension* BPExtension, bool bShouldRemoveFailedBindings, TArray<EMDStyleSetBindingExecutionResult>* OutResults = nullptr);
+
+	// Finds the property the binding writes to, including properties of widgets that don't exist on the CDO of a widget blueprint
+	static FMDStyleSetBindingTarget ResolveBindingTarget(UBlueprint* Blueprint, const FPropertyBindingDataView BaseValueView, const FMDStyleSetPropertyBinding& Binding);
 
 	virtual void BeginDestroy() override;
 
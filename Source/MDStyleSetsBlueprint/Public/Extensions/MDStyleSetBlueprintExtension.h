@@ -24,6 +24,27 @@ public:
 	const FMDStyleSetPropertyBinding* FindBindingForProperty(const FPropertyBindingPath& PropertyPath) const;
 	bool RemoveBindingForProperty(const FPropertyBindingPath& PropertyPath);
 
+	virtual void PostLoad() override;
+	virtual void PostEditUndo() override;
+
+	// Must be called after modifying Bindings without AddBinding or RemoveBindingForProperty
+	void RebuildBindingIndex() const;
+
+	// Hash of the bindings and the content of the Style Sets they use
+	FString CalculateContentHash() const;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Style Set")
 	TArray<FMDStyleSetPropertyBinding> Bindings;
+
+	// Content hash of the bindings when they were last baked, saved with the blueprint so its compiles can skip re-baking values that are already up to date
+	UPROPERTY()
+	FString BakedContentHash;
+
+private:
+	static uint32 GetPathHash(const FPropertyBindingPath& PropertyPath);
+
+	int32 FindBindingIndex(const FPropertyBindingPath& PropertyPath) const;
+
+	// Indices into Bindings keyed by the hash of their target property path, so the details panel can query each property row without scanning every binding
+	mutable TMultiMap<uint32, int32> BindingIndex;
 };
@@ -0,0 +1,24 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "WidgetBlueprintExtension.h"
+
+#include "MDStyleSetWidgetBlueprintExtension.generated.h"
+
+/**
+ * Bakes a widget blueprint's Style Set Property Bindings into its generated class so they can be re-applied at runtime
+ */
+UCLASS()
+class MDSTYLESETSBLUEPRINT_API UMDStyleSetWidgetBlueprintExtension : public UWidgetBlueprintExtension
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void HandleBeginCompilation(FWidgetBlueprintCompilerContext& InCreationContext) override;
+	virtual void HandleFinishCompilingClass(UWidgetBlueprintGeneratedClass* Class) override;
+	virtual void HandleEndCompilation() override;
+
+private:
+	FWidgetBlueprintCompilerContext* CompilerContext = nullptr;
+};
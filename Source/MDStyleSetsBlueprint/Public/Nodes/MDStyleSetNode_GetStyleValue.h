@@ -32,6 +32,7 @@ public:
 	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
 	virtual void PinDefaultValueChanged(UEdGraphPin* Pin) override;
 	virtual void ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
 
 	virtual UObject* GetJumpTargetForDoubleClick() const override;
 	virtual bool CanJumpToDefinition() const override;
@@ -44,12 +45,27 @@ public:
 	UPROPERTY()
 	TObjectPtr<UMDStyleSet> BoundStyleSet;
 
+	// When the Style Tag isn't connected, bake the value into the connected pins when compiling instead of looking it up each time the node runs.
+	// The baked value ignores theme overrides and Style Sets modified at runtime, and edits to the Style Set only apply once the blueprint is recompiled.
+	UPROPERTY(EditAnywhere, Category = "Style Set")
+	bool bFoldConstantValue = false;
+
 	FSimpleMulticastDelegate OnUpdatePreview;
 
 private:
 	void UpdatePinData();
 	void UpdatePreviewWidget();
 
+	// Replaces the links of the value pin with the style value as a literal default value where the linked pins support it
+	void FoldConstantValue(FKismetCompilerContext& CompilerContext);
+
+	// Calls the cached version of GetStyleValue when the Style Tag is connected, with a variable per node to remember the last value it read
+	void ExpandCachedLookup(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
+	bool IsBoundToStyleSet(const UObject* StyleSet) const;
+
 	void OnPropertyValueChanged(UObject* Object, FPropertyChangedEvent& Event);
 
+	// Style type read from the asset registry by template nodes whose Style Set isn't loaded
+	TOptional<FEdGraphPinType> TemplateStyleType;
+
 };
@@ -0,0 +1,49 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "AssetRegistry/AssetData.h"
+#include "GameplayTagContainer.h"
+
+class FAssetRegistryTagsContext;
+class FObjectPostSaveContext;
+class UBlueprint;
+class UMDStyleSet;
+class UPackage;
+enum class EMDStyleSetBindingExecutionResult : uint8;
+
+/**
+ * Reverse index from Style Set values to the blueprints reading them, stored in an asset registry tag on each blueprint so it's available without loading them.
+ * The tag lists the blueprint's bindings, Get Style Value nodes and style value reference variables.
+ * When a Style Set is saved, the blueprints binding its changed values are re-baked without being recompiled.
+ * When cooking, Style Sets can strip the entries no blueprint reads.
+ */
+struct MDSTYLESETSBLUEPRINT_API FMDStyleSetBindingIndex
+{
+public:
+	static const FName BindingsAssetTagName;
+
+	static void Register();
+	static void Unregister();
+
+	// Finds the blueprints binding any of Tags or their child tags from StyleSet or from a Style Set that inherits from it, without loading them
+	static TArray<FAssetData> FindBlueprintsUsingStyleValues(const UMDStyleSet* StyleSet, const TSet<FGameplayTag>& Tags);
+
+	// Whether the blueprint's tag lists any binding, blueprints that only read style values with nodes or variables have nothing to re-bake
+	static bool HasBindings(const FAssetData& BlueprintAsset);
+
+	// Gathers the tags read from any Style Set, tags are gathered across Style Sets since themes can override a Style Set with another one at runtime.
+	// Returns false if a tag read from StyleSet may be missing, e.g. it's only known at runtime or a referencer was saved without the tag.
+	static bool GatherReferencedTags(const UMDStyleSet* StyleSet, TSet<FGameplayTag>& OutTags);
+
+	// Re-applies the blueprint's bindings to its CDO and widget tree without recompiling it, returns false if it has no bindings.
+	// OutResults is parallel to the blueprint's bindings.
+	static bool RebakeBlueprint(UBlueprint* Blueprint, TArray<EMDStyleSetBindingExecutionResult>* OutResults = nullptr);
+
+private:
+	static void OnGetExtraObjectTags(FAssetRegistryTagsContext Context);
+	static void OnAssetChanged(const FAssetData& AssetData);
+	static void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+
+	static void RebakeBlueprintsUsingStyleValues(const UMDStyleSet* StyleSet, const TSet<FGameplayTag>& Tags);
+};
@@ -0,0 +1,25 @@
+// Copyright Dylan Dumesnil. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UMDStyleSet;
+
+/**
+ * Finishes loading the Style Sets referenced by blueprints before their bindings and nodes need them.
+ * Style Sets are hard references that are loaded along with the blueprint, only the ones their linker deferred still need to be preloaded.
+ */
+struct MDSTYLESETSBLUEPRINT_API FMDStyleSetBlueprintPreloader
+{
+public:
+	// Collects the Style Sets referenced by the blueprint's bindings and Style Set nodes
+	static void GatherStyleSets(const UBlueprint* Blueprint, TSet<UMDStyleSet*>& OutStyleSets);
+
+	// Preloads each Style Set once, instead of once per binding or node using it
+	static void PreloadStyleSets(const TSet<UMDStyleSet*>& StyleSets);
+
+	// Finishes loading a Style Set that was deferred by its linker
+	static void PreloadStyleSet(UMDStyleSet* StyleSet);
+};
@@ -17,7 +17,6 @@
 #include "Slate/SObjectWidget.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "TypeHandlers/MDStyleSetTypeHandlerBase.h"
-#include "UObject/Package.h"
 #include "UObject/PropertyOptional.h"
 #include "WidgetBlueprint.h"
 #include "Widgets/Layout/SScaleBox.h"
@@ -107,14 +106,16 @@ namespace MDStyleSetsPropertyBindingExtension
 		}
 	}
 
-	static void AddStyleSetEntriesBindingMenuItems(FMenuBuilder& MenuBuilder, TWeakObjectPtr<UMDStyleSet> StyleSetPtr, TWeakObjectPtr<const UWidgetBlueprint> WidgetBPPtr, TWeakObjectPtr<UWidget> WidgetPtr, TSharedPtr<IPropertyHandle> PropertyHandle)
+	static void AddStyleSetEntriesBindingMenuItems(FMenuBuilder& MenuBuilder, FSoftObjectPath StyleSetPath, TWeakObjectPtr<const UWidgetBlueprint> WidgetBPPtr, TWeakObjectPtr<UWidget> WidgetPtr, TSharedPtr<IPropertyHandle> PropertyHandle)
 	{
-		if (!StyleSetPtr.IsValid())
+		// The Style Set is only loaded once its entries are needed
+		UMDStyleSet* StyleSet = Cast<UMDStyleSet>(StyleSetPath.TryLoad());
+		if (!IsValid(StyleSet))
 		{
 			return;
 		}
 
-		UMDStyleSet* StyleSet = StyleSetPtr.Get();
+		const TWeakObjectPtr<UMDStyleSet> StyleSetPtr = StyleSet;
 		MenuBuilder.AddMenuEntry(
 			FText::Format(INVTEXT("Open '{0}' Style Asset"), StyleSet->GetDisplayName()),
 			FText::GetEmpty(),
@@ -124,13 +125,13 @@ namespace MDStyleSetsPropertyBindingExtension
 
 		MenuBuilder.AddSeparator();
 
-		for (TPair<FGameplayTag, FMDStyleValue>& Pair : StyleSet->StyleEntries)
+		for (const FGameplayTag& StyleTag : StyleSet->GetStyleTags())
 		{
-			TSharedRef<SWidget> PreviewWidget = IsValid(StyleSet->TypeHandler) ? StyleSet->TypeHandler->CreateValuePreviewWidget(StyleSet, Pair.Key) : SNullWidget::NullWidget;
-			const FText ValuePreviewText = IsValid(StyleSet->TypeHandler) ? StyleSet->TypeHandler->CreateValuePreviewText(StyleSet, Pair.Key) : FText::GetEmpty();
-			const FText TagText = FText::FromString(Pair.Key.ToString().RightChop(StyleSet->StyleSetTag.ToString().Len() + 1));
+			TSharedRef<SWidget> PreviewWidget = IsValid(StyleSet->TypeHandler) ? StyleSet->TypeHandler->CreateValuePreviewWidget(StyleSet, StyleTag) : SNullWidget::NullWidget;
+			const FText ValuePreviewText = IsValid(StyleSet->TypeHandler) ? StyleSet->TypeHandler->CreateValuePreviewText(StyleSet, StyleTag) : FText::GetEmpty();
+			const FText TagText = FText::FromString(StyleTag.ToString().RightChop(StyleSet->StyleSetTag.ToString().Len() + 1));
 			const FText LabelText = ValuePreviewText.IsEmptyOrWhitespace() ? TagText : FText::Format(INVTEXT("{0} ({1})"), TagText, ValuePreviewText);
-			const FText ToolTipText = FText::Format(INVTEXT("{0}: {1}"), FText::FromString(Pair.Key.ToString()), StyleSet->GetValueDisplayName(Pair.Key));
+			const FText ToolTipText = FText::Format(INVTEXT("{0}: {1}"), FText::FromString(StyleTag.ToString()), StyleSet->GetValueDisplayName(StyleTag));
 
 			if (PreviewWidget == SNullWidget::NullWidget)
 			{
@@ -138,7 +139,7 @@ namespace MDStyleSetsPropertyBindingExtension
 					LabelText,
 					ToolTipText,
 					FSlateIcon(),
-					FUIAction(FExecuteAction::CreateStatic(&CreateStyleBinding, StyleSetPtr, Pair.Key, WidgetBPPtr, WidgetPtr, PropertyHandle))
+					FUIAction(FExecuteAction::CreateStatic(&CreateStyleBinding, StyleSetPtr, StyleTag, WidgetBPPtr, WidgetPtr, PropertyHandle))
 				);
 			}
 			else
@@ -167,7 +168,7 @@ namespace MDStyleSetsPropertyBindingExtension
 						.Text(LabelText)
 					];
 				MenuBuilder.AddMenuEntry(
-					FUIAction(FExecuteAction::CreateStatic(&CreateStyleBinding, StyleSetPtr, Pair.Key, WidgetBPPtr, WidgetPtr, PropertyHandle)),
+					FUIAction(FExecuteAction::CreateStatic(&CreateStyleBinding, StyleSetPtr, StyleTag, WidgetBPPtr, WidgetPtr, PropertyHandle)),
 					MenuWidget,
 					NAME_None,
 					ToolTipText
@@ -185,19 +186,14 @@ namespace MDStyleSetsPropertyBindingExtension
 			const FProperty* PropertyPtr = PropertyHandle->GetProperty();
 			const FPropertyBagPropertyDesc Desc(PropertyPtr->GetFName(), PropertyPtr);
 
-			TArray<UMDStyleSet*> StyleSets = UMDStyleSetFunctionLibrary::GetConvertibleStyleSets(Desc);
-
-			for (UMDStyleSet* StyleSet : StyleSets)
+			for (const FAssetData& StyleAsset : UMDStyleSetFunctionLibrary::GetConvertibleStyleSetAssets(Desc))
 			{
-				if (IsValid(StyleSet))
-				{
-					MenuBuilder.AddSubMenu(
-						StyleSet->GetDisplayName(),
-						StyleSet->GetPackage()->GetLoadedPath().GetDebugNameText(),
-						FNewMenuDelegate::CreateStatic(&AddStyleSetEntriesBindingMenuItems, MakeWeakObjectPtr(StyleSet), WidgetBlueprint, Widget, PropertyHandle),
-						false
-					);
-				}
+				MenuBuilder.AddSubMenu(
+					UMDStyleSet::GetDisplayNameFromAssetData(StyleAsset),
+					FText::Format(INVTEXT("{0}\n{1} styles"), FText::FromName(StyleAsset.PackageName), UMDStyleSet::GetEntryCountFromAssetData(StyleAsset)),
+					FNewMenuDelegate::CreateStatic(&AddStyleSetEntriesBindingMenuItems, StyleAsset.GetSoftObjectPath(), WidgetBlueprint, Widget, PropertyHandle),
+					false
+				);
 			}
 
 			MenuBuilder.EndSection();
@@ -237,6 +233,17 @@ bool FMDStyleSetsPropertyBindingExtension::CanExtend(const UWidgetBlueprint* Wid
 	return false;
 }
 
+FMDStyleSetsPropertyBindingExtension::~FMDStyleSetsPropertyBindingExtension()
+{
+	for (const TPair<FObjectKey, FBlueprintPathCache>& Pair : PathCaches)
+	{
+		if (UBlueprint* Blueprint = Pair.Value.Blueprint.Get())
+		{
+			Blueprint->OnChanged().Remove(Pair.Value.ChangedHandle);
+		}
+	}
+}
+
 TSharedPtr<FExtender> FMDStyleSetsPropertyBindingExtension::CreateMenuExtender(const UWidgetBlueprint* WidgetBlueprint, UWidget* Widget, TSharedPtr<IPropertyHandle> PropertyHandle)
 {
 	TSharedPtr<FExtender> Extender = MakeShared<FExtender>();
@@ -255,7 +262,7 @@ void FMDStyleSetsPropertyBindingExtension::ClearCurrentValue(const UWidgetBluepr
 		UMDStyleSetBlueprintExtension* Extension = UMDStyleSetBlueprintExtension::GetExtension(WidgetBlueprint);
 		if (IsValid(Extension))
 		{
-			const FPropertyBindingPath PropertyBindingPath = MDStyleSetsPropertyBindingExtension::BuildPropertyPath(WidgetBlueprint, const_cast<UWidget*>(Widget), PropertyHandle);
+			const FPropertyBindingPath PropertyBindingPath = GetPropertyPath(WidgetBlueprint, Widget, PropertyHandle);
 			if (const FMDStyleSetPropertyBinding* Binding = Extension->FindBindingForProperty(PropertyBindingPath))
 			{
 				FScopedTransaction ClearBindingTransaction(FText::Format(INVTEXT("Removed Style Binding for '{0}' to '{1} - {2}'"),
@@ -273,7 +280,7 @@ TOptional<FName> FMDStyleSetsPropertyBindingExtension::GetCurrentValue(const UWi
 		UMDStyleSetBlueprintExtension* Extension = UMDStyleSetBlueprintExtension::GetExtension(WidgetBlueprint);
 		if (IsValid(Extension))
 		{
-			const FPropertyBindingPath PropertyBindingPath = MDStyleSetsPropertyBindingExtension::BuildPropertyPath(WidgetBlueprint, const_cast<UWidget*>(Widget), PropertyHandle);
+			const FPropertyBindingPath PropertyBindingPath = GetPropertyPath(WidgetBlueprint, Widget, PropertyHandle);
 			if (const FMDStyleSetPropertyBinding* Binding = Extension->FindBindingForProperty(PropertyBindingPath))
 			{
 				return Binding->Value.StyleValueTag.GetTagName();
@@ -291,7 +298,7 @@ const FSlateBrush* FMDStyleSetsPropertyBindingExtension::GetCurrentIcon(const UW
 		UMDStyleSetBlueprintExtension* Extension = UMDStyleSetBlueprintExtension::GetExtension(WidgetBlueprint);
 		if (IsValid(Extension))
 		{
-			const FPropertyBindingPath PropertyBindingPath = MDStyleSetsPropertyBindingExtension::BuildPropertyPath(WidgetBlueprint, const_cast<UWidget*>(Widget), PropertyHandle);
+			const FPropertyBindingPath PropertyBindingPath = GetPropertyPath(WidgetBlueprint, Widget, PropertyHandle);
 			if (const FMDStyleSetPropertyBinding* Binding = Extension->FindBindingForProperty(PropertyBindingPath))
 			{
 				if (const UMDStyleSet* StyleSet = Binding->Value.StyleSet)
@@ -304,3 +311,39 @@ const FSlateBrush* FMDStyleSetsPropertyBindingExtension::GetCurrentIcon(const UW
 
 	return nullptr;
 }
+
+FPropertyBindingPath FMDStyleSetsPropertyBindingExtension::GetPropertyPath(const UWidgetBlueprint* WidgetBlueprint, const UWidget* Widget, const TSharedPtr<IPropertyHandle>& PropertyHandle) const
+{
+	if (!PropertyHandle.IsValid() || !IsValid(WidgetBlueprint) || !IsValid(Widget))
+	{
+		return {};
+	}
+
+	FBlueprintPathCache* Cache = PathCaches.Find(WidgetBlueprint);
+	if (Cache == nullptr)
+	{
+		UWidgetBlueprint* MutableWidgetBP = const_cast<UWidgetBlueprint*>(WidgetBlueprint);
+		Cache = &PathCaches.Add(WidgetBlueprint);
+		Cache->Blueprint = MutableWidgetBP;
+		// Fires when the blueprint is compiled or structurally modified, which is when widgets and their properties can change
+		Cache->ChangedHandle = MutableWidgetBP->OnChanged().AddRaw(this, &FMDStyleSetsPropertyBindingExtension::OnBlueprintChanged);
+	}
+
+	// The widget name is part of the key so renaming a widget in the designer doesn't return its old path
+	const TTuple<FObjectKey, FName, FString> Key(Widget, Widget->GetFName(), PropertyHandle->GeneratePathToProperty());
+	if (const FPropertyBindingPath* CachedPath = Cache->Paths.Find(Key))
+	{
+		return *CachedPath;
+	}
+
+	return Cache->Paths.Add(Key, MDStyleSetsPropertyBindingExtension::BuildPropertyPath(WidgetBlueprint, const_cast<UWidget*>(Widget), PropertyHandle));
+}
+
+void FMDStyleSetsPropertyBindingExtension::OnBlueprintChanged(UBlueprint* Blueprint) const
+{
+	FBlueprintPathCache Cache;
+	if (PathCaches.RemoveAndCopyValue(Blueprint, Cache) && IsValid(Blueprint))
+	{
+		Blueprint->OnChanged().Remove(Cache.ChangedHandle);
+	}
+}
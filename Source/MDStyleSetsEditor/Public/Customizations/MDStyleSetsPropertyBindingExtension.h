@@ -3,11 +3,15 @@
 #pragma once
 
 #include "IHasPropertyBindingExtensibility.h"
+#include "PropertyBindingPath.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
 
 class MDSTYLESETSEDITOR_API FMDStyleSetsPropertyBindingExtension : public IPropertyBindingExtension
 {
 public:
-	virtual ~FMDStyleSetsPropertyBindingExtension() {}
+	virtual ~FMDStyleSetsPropertyBindingExtension();
 
 	virtual bool CanExtend(const UWidgetBlueprint* WidgetBlueprint, const UWidget* Widget, TSharedPtr<const IPropertyHandle> PropertyHandle) const override;
 	virtual TSharedPtr<FExtender> CreateMenuExtender(const UWidgetBlueprint* WidgetBlueprint, UWidget* Widget, TSharedPtr<IPropertyHandle> PropertyHandle) override;
@@ -16,4 +20,20 @@ public:
 	virtual void ClearCurrentValue(const UWidgetBlueprint* WidgetBlueprint, const UWidget* Widget, TSharedPtr<IPropertyHandle> PropertyHandle) override;
 	virtual TOptional<FName> GetCurrentValue(const UWidgetBlueprint* WidgetBlueprint, const UWidget* Widget, TSharedPtr<IPropertyHandle> PropertyHandle) const override;
 	virtual const FSlateBrush* GetCurrentIcon(const UWidgetBlueprint* WidgetBlueprint, const UWidget* Widget, TSharedPtr<IPropertyHandle> PropertyHandle) const override;
+
+private:
+	// Paths built for the property rows of a blueprint, keyed by widget, widget name and property handle path
+	struct FBlueprintPathCache
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		FDelegateHandle ChangedHandle;
+		TMap<TTuple<FObjectKey, FName, FString>, FPropertyBindingPath> Paths;
+	};
+
+	// The details panel queries every visible property row on each refresh, so the built paths are kept until the blueprint changes
+	FPropertyBindingPath GetPropertyPath(const UWidgetBlueprint* WidgetBlueprint, const UWidget* Widget, const TSharedPtr<IPropertyHandle>& PropertyHandle) const;
+
+	void OnBlueprintChanged(UBlueprint* Blueprint) const;
+
+	mutable TMap<FObjectKey, FBlueprintPathCache> PathCaches;
 };